@@ -1,19 +1,256 @@
 #include <iostream>
 #include <vector>
-#include <queue>
-#include <unordered_map>
 #include <cctype>
 #include <cstring>
 #include <string>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <climits>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
 // ========================
-// 1. Bitmap ࣨ޸棩
+// 1. Bitmap ࣨ64 λִ洢֧ rank/select 㣩
 // ========================
 typedef int Rank;
 
+inline int popcnt64(uint64_t x) {
+#if defined(_MSC_VER)
+    return (int)__popcnt64(x);
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+inline int ctz64(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return (int)i;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
 class Bitmap {
+private:
+    uint64_t* M;
+    Rank N, _sz;   // N_szλλתʱ£
+
+    // rank blockRank[b] = ǰ b  512 λеλдؽ
+    mutable vector<Rank> blockRank;
+    mutable bool rankDirty;
+
+    static const int BLOCK_WORDS = 8;
+
+protected:
+    void init(Rank n) {
+        N = (Rank)(((long long)n + 63) / 64);
+        if (N < 1) N = 1;
+        M = new uint64_t[N];
+        memset(M, 0, N * sizeof(uint64_t));
+        _sz = 0;
+        rankDirty = true;
+    }
+
+    void recount() {
+        Rank c = 0;
+        for (Rank i = 0; i < N; ++i) c += popcnt64(M[i]);
+        _sz = c;
+        rankDirty = true;
+    }
+
+    void buildRank() const {
+        Rank blocks = (N + BLOCK_WORDS - 1) / BLOCK_WORDS;
+        blockRank.assign(blocks + 1, 0);
+        for (Rank b = 0; b < blocks; ++b) {
+            Rank c = 0;
+            Rank hi = min(N, (b + 1) * BLOCK_WORDS);
+            for (Rank w = b * BLOCK_WORDS; w < hi; ++w) c += popcnt64(M[w]);
+            blockRank[b + 1] = blockRank[b] + c;
+        }
+        rankDirty = false;
+    }
+
+public:
+    // ĬϹ죺ܴ n λλͼ
+    Bitmap(Rank n = 64) { init(n); }
+
+    Bitmap(const Bitmap& other) : M(nullptr) { *this = other; }
+
+    Bitmap& operator=(const Bitmap& other) {
+        if (this == &other) return *this;
+        delete[] M;
+        N = other.N;
+        M = new uint64_t[N];
+        memcpy(M, other.M, N * sizeof(uint64_t));
+        _sz = other._sz;
+        rankDirty = true;
+        return *this;
+    }
+
+    ~Bitmap() {
+        delete[] M;
+        M = nullptr;
+        _sz = 0;
+    }
+
+    Rank size() const { return _sz; }
+    size_t byteSize() const { return (size_t)N * sizeof(uint64_t); }
+
+    // Զչдã
+    void expand(Rank k) {
+        if ((k >> 6) < N) return;
+        Rank words = (k >> 6) + 1;
+        growWords(min(2 * words, (Rank)1 << 25)); //  k+1 λ2^25 ּȫ int ±꣩
+    }
+
+    void growWords(Rank words) {
+        if (words <= N) return;
+        uint64_t* newM = new uint64_t[words];
+        memcpy(newM, M, N * sizeof(uint64_t));
+        memset(newM + N, 0, (words - N) * sizeof(uint64_t));
+        delete[] M;
+        M = newM;
+        N = words;
+        rankDirty = true;
+    }
+
+    void set(Rank k) {
+        expand(k);
+        uint64_t& w = M[k >> 6];
+        uint64_t bit = 1ULL << (k & 63);
+        _sz += !(w & bit);   //  0 -> 1 ʱ
+        w |= bit;
+        rankDirty = true;
+    }
+
+    void clear(Rank k) {
+        if ((k >> 6) >= N) return;
+        uint64_t& w = M[k >> 6];
+        uint64_t bit = 1ULL << (k & 63);
+        _sz -= (w & bit) != 0;
+        w &= ~bit;
+        rankDirty = true;
+    }
+
+    // ԽΪ 0
+    bool test(Rank k) const {
+        if ((k >> 6) >= N) return false;
+        return (M[k >> 6] >> (k & 63)) & 1;
+    }
+
+    // [0, k) λĸ
+    Rank rank(Rank k) const {
+        if (k <= 0) return 0;
+        if ((k >> 6) >= N) return _sz;
+        if (rankDirty) buildRank();
+        Rank w = k >> 6;
+        Rank r = blockRank[w / BLOCK_WORDS];
+        for (Rank i = w / BLOCK_WORDS * BLOCK_WORDS; i < w; ++i) r += popcnt64(M[i]);
+        if (k & 63) r += popcnt64(M[w] & ((1ULL << (k & 63)) - 1));
+        return r;
+    }
+
+    //  j λ 0 ƣλãʱ -1
+    Rank select(Rank j) const {
+        if (j < 0 || j >= _sz) return -1;
+        if (rankDirty) buildRank();
+        // ҵ j λĿ
+        Rank lo = 0, hi = (Rank)blockRank.size() - 1;
+        while (lo + 1 < hi) {
+            Rank mid = (lo + hi) / 2;
+            if (blockRank[mid] <= j) lo = mid; else hi = mid;
+        }
+        j -= blockRank[lo];
+        Rank w = lo * BLOCK_WORDS;
+        while (true) {
+            int c = popcnt64(M[w]);
+            if (j < c) break;
+            j -= c;
+            w++;
+        }
+        uint64_t x = M[w];
+        while (j-- > 0) x &= x - 1;   // λ j  1
+        return 64 * w + ctz64(x);
+    }
+
+    // 㣺 64 λִѭ޷֧ڱ
+    void andWith(const Bitmap& o) {
+        Rank n = min(N, o.N);
+        uint64_t* __restrict a = M;
+        const uint64_t* __restrict b = o.M;
+        for (Rank i = 0; i < n; ++i) a[i] &= b[i];
+        for (Rank i = n; i < N; ++i) a[i] = 0;
+        recount();
+    }
+
+    void orWith(const Bitmap& o) {
+        growWords(o.N);
+        uint64_t* __restrict a = M;
+        const uint64_t* __restrict b = o.M;
+        for (Rank i = 0; i < o.N; ++i) a[i] |= b[i];
+        recount();
+    }
+
+    void xorWith(const Bitmap& o) {
+        growWords(o.N);
+        uint64_t* __restrict a = M;
+        const uint64_t* __restrict b = o.M;
+        for (Rank i = 0; i < o.N; ++i) a[i] ^= b[i];
+        recount();
+    }
+
+    void andNotWith(const Bitmap& o) {
+        Rank n = min(N, o.N);
+        uint64_t* __restrict a = M;
+        const uint64_t* __restrict b = o.M;
+        for (Rank i = 0; i < n; ++i) a[i] &= ~b[i];
+        recount();
+    }
+
+    // ǰ n λתΪ "01" ַֽڲһд 8 ַ
+    char* bits2string(Rank n) const {
+        struct CharTable {
+            char t[256][8];
+            CharTable() {
+                for (int b = 0; b < 256; ++b)
+                    for (int i = 0; i < 8; ++i) t[b][i] = (b >> i) & 1 ? '1' : '0';
+            }
+        };
+        static const CharTable table;
+        char* s = new char[n + 1];
+        Rank full = (Rank)(min<long long>(n, 64LL * N) / 8);
+        for (Rank i = 0; i < full; ++i) {
+            uint64_t w = M[i >> 3] >> (8 * (i & 7));
+            memcpy(s + 8 * i, table.t[w & 0xFF], 8);
+        }
+        for (Rank i = 8 * full; i < n; ++i) s[i] = test(i) ? '1' : '0';
+        s[n] = '\0';
+        return s;
+    }
+};
+
+// ԭֽʵ֣ÿ set/clear/test  expandڻ׼Ա
+class ByteBitmap {
 private:
     unsigned char* M;
     Rank N, _sz;
@@ -27,9 +264,9 @@ protected:
 
 public:
     // ĬϹ죺ܴ n λλͼ
-    Bitmap(Rank n = 8) { init(n); }
+    ByteBitmap(Rank n = 8) { init(n); }
 
-    ~Bitmap() {
+    ~ByteBitmap() {
         delete[] M;
         M = nullptr;
         _sz = 0;
@@ -77,55 +314,1140 @@ public:
 };
 
 // ========================
-// 2. ڵṹ
+// 2. RoaringBitmap ѹλͼϡ衢ۼ 32 λ ID ϣ
 // ========================
-struct BinTree {
-    char ch;               // Ҷڵ洢ַ
-    int freq;              // Ƶ
-    BinTree* left;
-    BinTree* right;
+//  16 λΪţÿ 65536 λѡã
+//   ARRAY   uint16 飨Ԫز 4096 
+//   BITSET 1024  64 λ
+//   RUN    (, -1) ŵγ̱
+struct RoaringContainer {
+    enum { ARRAY = 1, BITSET = 2, RUN = 3 };
+    static const int ARRAY_MAX = 4096;
+    static const int WORDS = 1024;
+
+    uint8_t type;
+    int card;
+    vector<uint16_t> arr;
+    vector<uint64_t> bits;
+    vector<uint16_t> runs;
+
+    RoaringContainer() : type(ARRAY), card(0) {}
+
+    static bool arrayContains(const uint16_t* a, int n, uint16_t x) {
+        return binary_search(a, a + n, x);
+    }
+
+    // ҵһ <= x γ
+    static bool runContains(const uint16_t* r, int nr, uint16_t x) {
+        int lo = 0, hi = nr;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (r[2 * mid] <= x) lo = mid + 1; else hi = mid;
+        }
+        return lo > 0 && x - r[2 * (lo - 1)] <= r[2 * (lo - 1) + 1];
+    }
+
+    static void setRange(uint64_t* w, int lo, int hi) {   // λ [lo, hi]
+        int a = lo >> 6, b = hi >> 6;
+        uint64_t first = ~0ULL << (lo & 63), last = ~0ULL >> (63 - (hi & 63));
+        if (a == b) { w[a] |= first & last; return; }
+        w[a] |= first;
+        for (int i = a + 1; i < b; ++i) w[i] = ~0ULL;
+        w[b] |= last;
+    }
+
+    bool contains(uint16_t x) const {
+        switch (type) {
+        case ARRAY: return arrayContains(arr.data(), (int)arr.size(), x);
+        case BITSET: return (bits[x >> 6] >> (x & 63)) & 1;
+        default: return runContains(runs.data(), (int)runs.size() / 2, x);
+        }
+    }
+
+    // չ 1024 ֣÷㣩
+    void fillWords(uint64_t* w) const {
+        if (type == BITSET) {
+            memcpy(w, bits.data(), WORDS * sizeof(uint64_t));
+        } else if (type == ARRAY) {
+            for (uint16_t v : arr) w[v >> 6] |= 1ULL << (v & 63);
+        } else {
+            for (size_t i = 0; i < runs.size(); i += 2) setRange(w, runs[i], runs[i] + runs[i + 1]);
+        }
+    }
+
+    // λؽѡռÿռСıʾallowRun Ϊ false ʱ RUN
+    void assignWords(const uint64_t* w, bool allowRun = true) {
+        int c = 0, nr = 0;
+        uint64_t carry = 0;
+        for (int i = 0; i < WORDS; ++i) {
+            c += popcnt64(w[i]);
+            nr += popcnt64(w[i] & ~((w[i] << 1) | carry));   // γ
+            carry = w[i] >> 63;
+        }
+        arr.clear(); bits.clear(); runs.clear();
+        card = c;
+        size_t arrBytes = c <= ARRAY_MAX ? 2 * (size_t)c : SIZE_MAX;
+        size_t runBytes = allowRun ? 4 * (size_t)nr : SIZE_MAX;
+        size_t bitBytes = WORDS * sizeof(uint64_t);
+        if (runBytes < arrBytes && runBytes < bitBytes) {
+            type = RUN;
+            runs.reserve(2 * nr);
+            int i = 0;
+            while (i < 65536) {
+                uint64_t word = w[i >> 6] >> (i & 63);
+                if (!word) { i = (i | 63) + 1; continue; }
+                i += ctz64(word);
+                int start = i;
+                while (i < 65536 && ((w[i >> 6] >> (i & 63)) & 1)) {
+                    uint64_t rest = ~(w[i >> 6] >> (i & 63));
+                    i += rest ? ctz64(rest) : 64 - (i & 63);
+                }
+                runs.push_back((uint16_t)start);
+                runs.push_back((uint16_t)(i - 1 - start));
+            }
+        } else if (arrBytes <= bitBytes) {
+            type = ARRAY;
+            arr.reserve(c);
+            for (int i = 0; i < WORDS; ++i) {
+                for (uint64_t x = w[i]; x; x &= x - 1) arr.push_back((uint16_t)(64 * i + ctz64(x)));
+            }
+        } else {
+            type = BITSET;
+            bits.assign(w, w + WORDS);
+        }
+    }
+
+    void optimize() {
+        uint64_t w[WORDS] = {0};
+        fillWords(w);
+        assignWords(w);
+    }
+
+    void add(uint16_t x) {
+        if (contains(x)) return;
+        if (type == ARRAY && card < ARRAY_MAX) {
+            arr.insert(lower_bound(arr.begin(), arr.end(), x), x);
+            card++;
+            return;
+        }
+        if (type == RUN) {
+            addToRuns(x);
+            card++;
+            if (runs.size() * 2 > WORDS * sizeof(uint64_t)) optimize();   // γ̱λʱѡʾ
+            return;
+        }
+        if (type != BITSET) {   // תΪλ
+            uint64_t w[WORDS] = {0};
+            fillWords(w);
+            arr.clear();
+            runs.clear();
+            bits.assign(w, w + WORDS);
+            type = BITSET;
+        }
+        bits[x >> 6] |= 1ULL << (x & 63);
+        card++;
+    }
+
+    // Ѳڼе x γ̣ǰγʱӳϲ볤Ϊ 0 γ
+    void addToRuns(uint16_t x) {
+        int nr = (int)runs.size() / 2, lo = 0, hi = nr;
+        while (lo < hi) {   // һ > x γ
+            int mid = (lo + hi) / 2;
+            if (runs[2 * mid] <= x) lo = mid + 1; else hi = mid;
+        }
+        bool joinPrev = lo > 0 && runs[2 * (lo - 1)] + runs[2 * (lo - 1) + 1] + 1 == x;
+        bool joinNext = lo < nr && x + 1 == runs[2 * lo];
+        if (joinPrev && joinNext) {
+            runs[2 * (lo - 1) + 1] += runs[2 * lo + 1] + 2;
+            runs.erase(runs.begin() + 2 * lo, runs.begin() + 2 * lo + 2);
+        } else if (joinPrev) {
+            runs[2 * (lo - 1) + 1]++;
+        } else if (joinNext) {
+            runs[2 * lo] = x;
+            runs[2 * lo + 1]++;
+        } else {
+            uint16_t run[2] = {x, 0};
+            runs.insert(runs.begin() + 2 * lo, run, run + 2);
+        }
+    }
+
+    void remove(uint16_t x) {
+        if (!contains(x)) return;
+        if (type == ARRAY) {
+            arr.erase(lower_bound(arr.begin(), arr.end(), x));
+            card--;
+            return;
+        }
+        uint64_t w[WORDS] = {0};
+        if (type == BITSET) {
+            bits[x >> 6] &= ~(1ULL << (x & 63));
+            if (--card > ARRAY_MAX) return;
+            memcpy(w, bits.data(), sizeof(w));   //  4096 ʱת
+            assignWords(w, false);
+            return;
+        }
+        fillWords(w);
+        w[x >> 6] &= ~(1ULL << (x & 63));
+        assignWords(w);
+    }
+
+    size_t sizeInBytes() const {
+        return sizeof(RoaringContainer) + arr.size() * 2 + bits.size() * 8 + runs.size() * 2;
+    }
+
+    // 伯㣺op Ϊ '&' '|' '^' '-'
+    static RoaringContainer combine(const RoaringContainer& a, const RoaringContainer& b, char op) {
+        RoaringContainer r;
+        if (a.type == ARRAY && b.type == ARRAY) {   // 飺Թ鲢
+            auto out = back_inserter(r.arr);
+            if (op == '&') set_intersection(a.arr.begin(), a.arr.end(), b.arr.begin(), b.arr.end(), out);
+            else if (op == '|') set_union(a.arr.begin(), a.arr.end(), b.arr.begin(), b.arr.end(), out);
+            else if (op == '^') set_symmetric_difference(a.arr.begin(), a.arr.end(), b.arr.begin(), b.arr.end(), out);
+            else set_difference(a.arr.begin(), a.arr.end(), b.arr.begin(), b.arr.end(), out);
+            r.card = (int)r.arr.size();
+            if (r.card > ARRAY_MAX) r.optimize();
+            return r;
+        }
+        if ((op == '&' && (a.type == ARRAY || b.type == ARRAY)) || (op == '-' && a.type == ARRAY)) {
+            const RoaringContainer& s = a.type == ARRAY ? a : b;   // ̽һ
+            const RoaringContainer& t = a.type == ARRAY ? b : a;
+            for (uint16_t v : s.arr) {
+                if (t.contains(v) == (op == '&')) r.arr.push_back(v);
+            }
+            r.card = (int)r.arr.size();
+            return r;
+        }
+        // չΪλ
+        uint64_t wa[WORDS] = {0}, wb[WORDS] = {0};
+        a.fillWords(wa);
+        b.fillWords(wb);
+        switch (op) {
+        case '&': for (int i = 0; i < WORDS; ++i) wa[i] &= wb[i]; break;
+        case '|': for (int i = 0; i < WORDS; ++i) wa[i] |= wb[i]; break;
+        case '^': for (int i = 0; i < WORDS; ++i) wa[i] ^= wb[i]; break;
+        default:  for (int i = 0; i < WORDS; ++i) wa[i] &= ~wb[i]; break;
+        }
+        r.assignWords(wa);
+        return r;
+    }
+};
+
+// лʽСֽ򣬿ֱ mmap ԭزѯ
+//   "RBM1" |  n4 ֽڣ| n  RoaringDesc | ݣ8 ֽڶ룩
+struct RoaringDesc {
+    uint16_t key;
+    uint8_t type;
+    uint8_t pad;
+    uint32_t card;
+    uint32_t count;    // ԪظARRAY Ϊ cardRUN Ϊ uint16 BITSET Ϊ 1024
+    uint32_t reserved;
+    uint64_t offset;   // ļʼֽƫ
+};
+static_assert(sizeof(RoaringDesc) == 24, "RoaringDesc must be packed to 24 bytes");
+
+const char ROARING_MAGIC[4] = {'R', 'B', 'M', '1'};
+
+class RoaringBitmap {
+private:
+    vector<uint16_t> keys;               // 
+    vector<RoaringContainer> cs;
+
+    int findKey(uint16_t hi) const {
+        auto it = lower_bound(keys.begin(), keys.end(), hi);
+        return (it != keys.end() && *it == hi) ? (int)(it - keys.begin()) : -1;
+    }
+
+public:
+    void add(uint32_t x) {
+        uint16_t hi = (uint16_t)(x >> 16);
+        auto it = lower_bound(keys.begin(), keys.end(), hi);
+        size_t i = it - keys.begin();
+        if (it == keys.end() || *it != hi) {
+            keys.insert(it, hi);
+            cs.insert(cs.begin() + i, RoaringContainer());
+        }
+        cs[i].add((uint16_t)x);
+    }
+
+    //  [lo, hi] ֱдγ
+    void addRange(uint32_t lo, uint32_t hi) {
+        if (lo > hi) return;
+        for (uint64_t base = lo & ~0xFFFFu; base <= hi; base += 65536) {
+            uint32_t a = max<uint64_t>(lo, base) - base;
+            uint32_t b = min<uint64_t>(hi, base + 65535) - base;
+            uint16_t key = (uint16_t)(base >> 16);
+            int i = findKey(key);
+            if (i < 0) {
+                auto it = lower_bound(keys.begin(), keys.end(), key);
+                i = (int)(it - keys.begin());
+                keys.insert(it, key);
+                cs.insert(cs.begin() + i, RoaringContainer());
+            }
+            RoaringContainer range;
+            range.type = RoaringContainer::RUN;
+            range.runs = {(uint16_t)a, (uint16_t)(b - a)};
+            range.card = (int)(b - a + 1);
+            cs[i] = RoaringContainer::combine(cs[i], range, '|');
+        }
+    }
+
+    void remove(uint32_t x) {
+        int i = findKey((uint16_t)(x >> 16));
+        if (i < 0) return;
+        cs[i].remove((uint16_t)x);
+        if (cs[i].card == 0) {
+            keys.erase(keys.begin() + i);
+            cs.erase(cs.begin() + i);
+        }
+    }
+
+    bool contains(uint32_t x) const {
+        int i = findKey((uint16_t)(x >> 16));
+        return i >= 0 && cs[i].contains((uint16_t)x);
+    }
+
+    uint64_t cardinality() const {
+        uint64_t c = 0;
+        for (const auto& ct : cs) c += ct.card;
+        return c;
+    }
+
+    // Ϊÿѡʡռıʾγ̣
+    void runOptimize() {
+        for (auto& ct : cs) ct.optimize();
+    }
 
-    BinTree(char c, int f) : ch(c), freq(f), left(nullptr), right(nullptr) {}
-    BinTree(int f, BinTree* l, BinTree* r) : ch(0), freq(f), left(l), right(r) {}
+    size_t sizeInBytes() const {
+        size_t s = sizeof(*this) + keys.size() * sizeof(uint16_t);
+        for (const auto& ct : cs) s += ct.sizeInBytes();
+        return s;
+    }
+
+    // Ź鲢λͼ
+    static RoaringBitmap combine(const RoaringBitmap& a, const RoaringBitmap& b, char op) {
+        RoaringBitmap r;
+        size_t i = 0, j = 0;
+        while (i < a.keys.size() || j < b.keys.size()) {
+            bool takeA = j == b.keys.size() || (i < a.keys.size() && a.keys[i] < b.keys[j]);
+            bool takeB = i == a.keys.size() || (j < b.keys.size() && b.keys[j] < a.keys[i]);
+            if (takeA) {
+                if (op != '&') { r.keys.push_back(a.keys[i]); r.cs.push_back(a.cs[i]); }
+                ++i;
+            } else if (takeB) {
+                if (op == '|' || op == '^') { r.keys.push_back(b.keys[j]); r.cs.push_back(b.cs[j]); }
+                ++j;
+            } else {
+                RoaringContainer c = RoaringContainer::combine(a.cs[i], b.cs[j], op);
+                if (c.card > 0) { r.keys.push_back(a.keys[i]); r.cs.push_back(move(c)); }
+                ++i; ++j;
+            }
+        }
+        return r;
+    }
+
+    RoaringBitmap operator&(const RoaringBitmap& o) const { return combine(*this, o, '&'); }
+    RoaringBitmap operator|(const RoaringBitmap& o) const { return combine(*this, o, '|'); }
+    RoaringBitmap operator^(const RoaringBitmap& o) const { return combine(*this, o, '^'); }
+    RoaringBitmap operator-(const RoaringBitmap& o) const { return combine(*this, o, '-'); }
+
+    bool serialize(ostream& os) const {
+        uint32_t n = (uint32_t)keys.size();
+        vector<RoaringDesc> desc(n);
+        uint64_t off = 8 + (uint64_t)n * sizeof(RoaringDesc);
+        for (uint32_t i = 0; i < n; ++i) {
+            const RoaringContainer& c = cs[i];
+            off = (off + 7) & ~7ULL;
+            desc[i].key = keys[i];
+            desc[i].type = c.type;
+            desc[i].pad = 0;
+            desc[i].card = (uint32_t)c.card;
+            desc[i].count = (uint32_t)(c.type == RoaringContainer::ARRAY ? c.arr.size()
+                                      : c.type == RoaringContainer::RUN ? c.runs.size()
+                                      : RoaringContainer::WORDS);
+            desc[i].reserved = 0;
+            desc[i].offset = off;
+            off += (uint64_t)desc[i].count * (c.type == RoaringContainer::BITSET ? 8 : 2);
+        }
+        os.write(ROARING_MAGIC, 4);
+        os.write((const char*)&n, 4);
+        os.write((const char*)desc.data(), n * sizeof(RoaringDesc));
+        uint64_t pos = 8 + (uint64_t)n * sizeof(RoaringDesc);
+        const char zeros[8] = {0};
+        for (uint32_t i = 0; i < n; ++i) {
+            os.write(zeros, desc[i].offset - pos);
+            const RoaringContainer& c = cs[i];
+            const char* p = c.type == RoaringContainer::ARRAY ? (const char*)c.arr.data()
+                          : c.type == RoaringContainer::RUN ? (const char*)c.runs.data()
+                          : (const char*)c.bits.data();
+            size_t bytes = (size_t)desc[i].count * (c.type == RoaringContainer::BITSET ? 8 : 2);
+            os.write(p, bytes);
+            pos = desc[i].offset + bytes;
+        }
+        return (bool)os;
+    }
+
+    friend class RoaringView;
 };
 
-// ȶбȽС
-struct Compare {
-    bool operator()(BinTree* a, BinTree* b) {
-        return a->freq > b->freq;
+// ֻͼֱлݣͨ mmap ӳļϲѯ
+class RoaringView {
+private:
+    const unsigned char* base;
+    const RoaringDesc* desc;
+    uint32_t n;
+    bool valid;
+
+    const void* payload(uint32_t i) const { return base + desc[i].offset; }
+
+    // ݱļ飺ϸγ̲Խ 65535һص
+    // card ʵʵԪظһ£cardinality  materialize ֱʹ card
+    static bool validPayload(const RoaringDesc& d, const unsigned char* p) {
+        uint64_t c = 0;
+        if (d.type == RoaringContainer::ARRAY) {
+            const uint16_t* a = (const uint16_t*)p;
+            for (uint32_t k = 1; k < d.count; ++k) {
+                if (a[k] <= a[k - 1]) return false;
+            }
+            return true;
+        }
+        if (d.type == RoaringContainer::BITSET) {
+            const uint64_t* w = (const uint64_t*)p;
+            for (uint32_t k = 0; k < d.count; ++k) c += popcnt64(w[k]);
+            return c == d.card;
+        }
+        const uint16_t* r = (const uint16_t*)p;
+        int64_t prevEnd = -1;
+        for (uint32_t k = 0; k < d.count; k += 2) {
+            uint32_t start = r[k], end = start + r[k + 1];
+            if (end > 65535 || (int64_t)start <= prevEnd) return false;
+            prevEnd = end;
+            c += r[k + 1] + 1;
+        }
+        return c == d.card;
+    }
+
+public:
+    RoaringView(const void* data, size_t len) : base((const unsigned char*)data), desc(nullptr), n(0), valid(false) {
+        // Уȫͨ desc  n𻵵ݵõһͼ
+        uint32_t count;
+        if (len < 8 || memcmp(base, ROARING_MAGIC, 4) != 0) return;
+        memcpy(&count, base + 4, 4);
+        if ((uint64_t)count * sizeof(RoaringDesc) > len - 8) return;
+        const RoaringDesc* d = (const RoaringDesc*)(base + 8);
+        for (uint32_t i = 0; i < count; ++i) {
+            if (d[i].type < RoaringContainer::ARRAY || d[i].type > RoaringContainer::RUN) return;
+            // ÿԪظѯʱĶһ
+            if (d[i].type == RoaringContainer::BITSET) {
+                if (d[i].count != RoaringContainer::WORDS || d[i].card > 65536) return;
+            } else if (d[i].type == RoaringContainer::RUN) {
+                if (d[i].count % 2 != 0 || d[i].count > 65536 * 2 || d[i].card > 65536) return;
+            } else {
+                if (d[i].count > (uint32_t)RoaringContainer::ARRAY_MAX || d[i].count != d[i].card) return;
+            }
+            uint64_t unit = d[i].type == RoaringContainer::BITSET ? 8 : 2;
+            if (d[i].offset % 8 != 0 || d[i].offset > len || d[i].count * unit > len - d[i].offset) return;
+            if (i > 0 && d[i].key <= d[i - 1].key) return;
+            if (!validPayload(d[i], base + d[i].offset)) return;
+        }
+        desc = d;
+        n = count;
+        valid = true;
+    }
+
+    bool ok() const { return valid; }
+
+    bool contains(uint32_t x) const {
+        uint16_t hi = (uint16_t)(x >> 16), lo = (uint16_t)x;
+        uint32_t l = 0, r = n;
+        while (l < r) {
+            uint32_t mid = (l + r) / 2;
+            if (desc[mid].key < hi) l = mid + 1; else r = mid;
+        }
+        if (l == n || desc[l].key != hi) return false;
+        const RoaringDesc& d = desc[l];
+        switch (d.type) {
+        case RoaringContainer::ARRAY:
+            return RoaringContainer::arrayContains((const uint16_t*)payload(l), (int)d.count, lo);
+        case RoaringContainer::BITSET:
+            return (((const uint64_t*)payload(l))[lo >> 6] >> (lo & 63)) & 1;
+        default:
+            return RoaringContainer::runContains((const uint16_t*)payload(l), (int)d.count / 2, lo);
+        }
+    }
+
+    uint64_t cardinality() const {
+        uint64_t c = 0;
+        for (uint32_t i = 0; i < n; ++i) c += desc[i].card;
+        return c;
+    }
+
+    // Ϊ޸ĵ RoaringBitmap
+    RoaringBitmap materialize() const {
+        RoaringBitmap rb;
+        for (uint32_t i = 0; i < n; ++i) {
+            RoaringContainer c;
+            c.type = desc[i].type;
+            c.card = (int)desc[i].card;
+            if (c.type == RoaringContainer::ARRAY) {
+                const uint16_t* p = (const uint16_t*)payload(i);
+                c.arr.assign(p, p + desc[i].count);
+            } else if (c.type == RoaringContainer::RUN) {
+                const uint16_t* p = (const uint16_t*)payload(i);
+                c.runs.assign(p, p + desc[i].count);
+            } else {
+                const uint64_t* p = (const uint64_t*)payload(i);
+                c.bits.assign(p, p + desc[i].count);
+            }
+            rb.keys.push_back(desc[i].key);
+            rb.cs.push_back(move(c));
+        }
+        return rb;
     }
 };
 
+// ֻļӳ䣨POSIX  mmapƽ̨˻Ϊ룩
+class MappedFile {
+private:
+    const unsigned char* addr;
+    size_t len;
+    vector<unsigned char> buf;
+    bool mapped;
+
+public:
+    MappedFile() : addr(nullptr), len(0), mapped(false) {}
+    ~MappedFile() { close(); }
+
+    bool open(const char* path) {
+        close();
+#if defined(_WIN32)
+        ifstream in(path, ios::binary);
+        if (!in) return false;
+        buf.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        addr = buf.data();
+        len = buf.size();
+        return true;
+#else
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+        len = (size_t)st.st_size;
+        if (len == 0) { ::close(fd); return true; }
+        void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) { len = 0; return false; }
+        addr = (const unsigned char*)p;
+        mapped = true;
+        return true;
+#endif
+    }
+
+    void close() {
+#if !defined(_WIN32)
+        if (mapped) munmap((void*)addr, len);
+#endif
+        mapped = false;
+        addr = nullptr;
+        len = 0;
+        buf.clear();
+    }
+
+    const unsigned char* data() const { return addr; }
+    size_t size() const { return len; }
+};
+
 // ========================
-// 3. ȫֱ
+// 3. Huffman Ƶͳ + ˫н + 볤
 // ========================
-unordered_map<char, Bitmap*> huffTable;
+const int HUFF_SYMS = 256;
+const int HUFF_MAX_LEN = 12;              // 볤ޣͬʱҲǲλ
+
+// ÿ߳һֱͼж룬̼߳α
+struct alignas(64) ByteHistogram {
+    uint64_t c[HUFF_SYMS];
+};
 
-// ݹ Huffman 
-void buildCodeTable(BinTree* node, Bitmap* code, int depth) {
-    if (!node) return;
+// ͳֽƵβۼӵ freqг threads βмϲ
+void countByteFreq(const unsigned char* data, size_t n, uint64_t freq[], int threads = 0) {
+    const size_t MIN_PER_THREAD = 1 << 20;   // ̫С벻ֵÿ߳
+    if (threads <= 0) threads = (int)max(1u, thread::hardware_concurrency());
+    threads = (int)min<size_t>(threads, max<size_t>(1, n / MIN_PER_THREAD));
+    vector<ByteHistogram> hist(threads);
 
-    if (!node->left && !node->right) {
-        // Ҷӽڵ㣺ַı
-        Bitmap* copy = new Bitmap(depth);
-        for (int i = 0; i < depth; ++i) {
-            if (code->test(i)) copy->set(i);
+    auto work = [&](int t) {
+        size_t lo = n * t / threads, hi = n * (t + 1) / threads;
+        // 4 ·ֱͼֽͬڲ໥ȴ
+        uint64_t sub[4][HUFF_SYMS] = {{0}};
+        size_t i = lo;
+        for (; i + 4 <= hi; i += 4) {
+            sub[0][data[i]]++;
+            sub[1][data[i + 1]]++;
+            sub[2][data[i + 2]]++;
+            sub[3][data[i + 3]]++;
         }
-        huffTable[node->ch] = copy;
+        for (; i < hi; ++i) sub[0][data[i]]++;
+        for (int s = 0; s < HUFF_SYMS; ++s) hist[t].c[s] = sub[0][s] + sub[1][s] + sub[2][s] + sub[3][s];
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(work, t);
+    work(0);
+    for (auto& th : pool) th.join();
+    for (int t = 0; t < threads; ++t)
+        for (int s = 0; s < HUFF_SYMS; ++s) freq[s] += hist[t].c[s];
+}
+
+// ƽеڵ㣺ǰ m ΪƵеҶӣΪڲڵ
+struct HuffNode {
+    uint64_t freq;
+    int parent;
+};
+
+// ˫ԽҶɵڲڵƵε
+// ÿֻȽס볤
+int twoQueueLengths(const vector<pair<uint64_t, int>>& leaves, uint8_t len[]) {
+    int m = (int)leaves.size();
+    vector<HuffNode> nodes(2 * m - 1);
+    for (int i = 0; i < m; ++i) nodes[i] = {leaves[i].first, -1};
+
+    int leaf = 0, inner = m;
+    auto takeMin = [&](int next) {
+        if (leaf < m && (inner >= next || nodes[leaf].freq <= nodes[inner].freq)) return leaf++;
+        return inner++;
+    };
+    for (int next = m; next < 2 * m - 1; ++next) {
+        int a = takeMin(next);
+        int b = takeMin(next);
+        nodes[next] = {nodes[a].freq + nodes[b].freq, -1};
+        nodes[a].parent = nodes[b].parent = next;
+    }
+
+    // ڵ±ܴӽڵ㣬һ˼
+    vector<int> depth(2 * m - 1, 0);
+    int maxLen = 0;
+    for (int k = 2 * m - 3; k >= 0; --k) {
+        depth[k] = depth[nodes[k].parent] + 1;
+        if (k < m) {
+            len[leaves[k].second] = (uint8_t)depth[k];
+            maxLen = max(maxLen, depth[k]);
+        }
+    }
+    return maxLen;
+}
+
+// Package-Merge볤 maxLen ǰ볤
+void packageMergeLengths(const vector<pair<uint64_t, int>>& leaves, int maxLen, uint8_t len[]) {
+    int m = (int)leaves.size();
+    // ÿбԪأleaf >= 0 ΪҶӣΪһ 2*pkg2*pkg+1 ɵİ
+    struct Item { uint64_t w; int leaf; int pkg; };
+    vector<vector<Item>> lists(maxLen);
+    for (int i = 0; i < m; ++i) lists[0].push_back({leaves[i].first, i, -1});
+    for (int l = 1; l < maxLen; ++l) {
+        const vector<Item>& prev = lists[l - 1];
+        vector<Item>& cur = lists[l];
+        int pi = 0, li = 0, packs = (int)prev.size() / 2;
+        while (li < m || pi < packs) {
+            uint64_t pw = pi < packs ? prev[2 * pi].w + prev[2 * pi + 1].w : 0;
+            if (li < m && (pi >= packs || leaves[li].first <= pw)) {
+                cur.push_back({leaves[li].first, li, -1});
+                ++li;
+            } else {
+                cur.push_back({pw, -1, pi});
+                ++pi;
+            }
+        }
+    }
+
+    // ȡǰ 2m-2 չÿҶӳֵĴ볤
+    vector<int> count(m, 0);
+    vector<pair<int, int>> todo;   // (, ±)
+    for (int i = 0; i < 2 * m - 2; ++i) todo.push_back({maxLen - 1, i});
+    while (!todo.empty()) {
+        pair<int, int> t = todo.back();
+        todo.pop_back();
+        const Item& it = lists[t.first][t.second];
+        if (it.leaf >= 0) {
+            count[it.leaf]++;
+        } else {
+            todo.push_back({t.first - 1, 2 * it.pkg});
+            todo.push_back({t.first - 1, 2 * it.pkg + 1});
+        }
+    }
+    for (int i = 0; i < m; ++i) len[leaves[i].second] = (uint8_t)count[i];
+}
+
+// Ƶμ볤˫ԼŽ⣬ʱ Package-Merge
+void buildHuffLengths(const uint64_t freq[], uint8_t len[]) {
+    memset(len, 0, HUFF_SYMS);
+    vector<pair<uint64_t, int>> leaves;
+    for (int i = 0; i < HUFF_SYMS; ++i) {
+        if (freq[i] > 0) leaves.push_back({freq[i], i});
+    }
+    if (leaves.empty()) return;
+    if (leaves.size() == 1) {               // ֻһֽʱҲռ 1 λ
+        len[leaves[0].second] = 1;
         return;
     }
+    sort(leaves.begin(), leaves.end());
+    if (twoQueueLengths(leaves, len) > HUFF_MAX_LEN) {
+        packageMergeLengths(leaves, HUFF_MAX_LEN, len);
+    }
+}
+
+// ========================
+// 4. ʽ Huffman ֧ȫ 256 ֵֽ
+// ========================
+const int HUFF_LUT_SIZE = 1 << HUFF_MAX_LEN;
+
+// code[s] = ( << 8) | 볤lut  HUFF_MAX_LEN λǰ׺һν 3 
+struct HuffCodec {
+    uint8_t len[HUFF_SYMS];
+    uint32_t code[HUFF_SYMS];
+    vector<uint32_t> lut;     // sym0 | sym1 << 8 | sym2 << 16 |  << 24 | λ << 26
+    vector<uint16_t> single;  // (sym << 4) | 볤βŽ
+
+    HuffCodec() : lut(HUFF_LUT_SIZE), single(HUFF_LUT_SIZE) {
+        memset(len, 0, sizeof(len));
+        memset(code, 0, sizeof(code));
+    }
+
+    void build(const uint64_t freq[], bool decodeTables = true) {
+        uint8_t lens[HUFF_SYMS];
+        buildHuffLengths(freq, lens);
+        fromLengths(lens, decodeTables);
+    }
+
+    // 볤䷶ʽ֣ͬ볤ɲұ볤Ƿʱ false
+    // ֻʱ decodeTables = falseұĹ
+    bool fromLengths(const uint8_t lens[], bool decodeTables = true) {
+        int count[HUFF_MAX_LEN + 1] = {0};
+        for (int s = 0; s < HUFF_SYMS; ++s) {
+            if (lens[s] > HUFF_MAX_LEN) return false;
+            count[lens[s]]++;
+        }
+        count[0] = 0;
+        uint32_t next[HUFF_MAX_LEN + 1] = {0};
+        uint32_t c = 0;
+        int kraft = 0;
+        for (int l = 1; l <= HUFF_MAX_LEN; ++l) {
+            c = (c + count[l - 1]) << 1;
+            next[l] = c;
+            kraft += count[l] << (HUFF_MAX_LEN - l);
+        }
+        if (kraft > HUFF_LUT_SIZE) return false;
+
+        memcpy(len, lens, HUFF_SYMS);
+        if (decodeTables) fill(single.begin(), single.end(), 0);
+        for (int s = 0; s < HUFF_SYMS; ++s) {
+            int l = len[s];
+            if (l == 0) { code[s] = 0; continue; }
+            uint32_t cw = next[l]++;
+            code[s] = (cw << 8) | l;
+            if (!decodeTables) continue;
+            uint32_t lo = cw << (HUFF_MAX_LEN - l), hi = (cw + 1) << (HUFF_MAX_LEN - l);
+            for (uint32_t k = lo; k < hi; ++k) single[k] = (uint16_t)((s << 4) | l);
+        }
+        if (!decodeTables) return true;
+
+        // ű HUFF_MAX_LEN λ̰ĵ룬 3 
+        for (uint32_t idx = 0; idx < (uint32_t)HUFF_LUT_SIZE; ++idx) {
+            uint32_t entry = 0;
+            int used = 0, cnt = 0;
+            while (cnt < 3) {
+                uint16_t e = single[(idx << used) & (HUFF_LUT_SIZE - 1)];
+                int l = e & 15;
+                if (l == 0 || used + l > HUFF_MAX_LEN) break;
+                entry |= (uint32_t)(e >> 4) << (8 * cnt);
+                used += l;
+                cnt++;
+            }
+            lut[idx] = entry | ((uint32_t)cnt << 24) | ((uint32_t)used << 26);
+        }
+        return true;
+    }
+};
+
+// תΪ "01" ַ
+string codeToString(uint32_t packed) {
+    int l = packed & 0xFF;
+    uint32_t cw = packed >> 8;
+    string s(l, '0');
+    for (int i = 0; i < l; ++i) {
+        if (cw & (1u << (l - 1 - i))) s[i] = '1';
+    }
+    return s;
+}
+
+// 64 λۼλдλǰÿ 32 λд
+class BitWriter {
+private:
+    vector<unsigned char>& out;
+    uint64_t acc;
+    int nbits;
+
+public:
+    BitWriter(vector<unsigned char>& o) : out(o), acc(0), nbits(0) {}
+
+    void put(uint32_t packed) {
+        int l = packed & 0xFF;
+        acc = (acc << l) | (packed >> 8);
+        nbits += l;
+        if (nbits >= 32) {
+            nbits -= 32;
+            uint32_t w = (uint32_t)(acc >> nbits);
+            unsigned char b[4] = {(unsigned char)(w >> 24), (unsigned char)(w >> 16),
+                                  (unsigned char)(w >> 8), (unsigned char)w};
+            out.insert(out.end(), b, b + 4);
+        }
+    }
+
+    // дʣλĩֽڵλ 0
+    void finish() {
+        while (nbits >= 8) {
+            nbits -= 8;
+            out.push_back((unsigned char)(acc >> nbits));
+        }
+        if (nbits > 0) out.push_back((unsigned char)(acc << (8 - nbits)));
+        acc = 0;
+        nbits = 0;
+    }
+};
+
+// λȡڴеһݶλ 0 
+class BitReader {
+private:
+    const unsigned char* p;
+    const unsigned char* end;
+    uint64_t acc;   // Чλ
+    int nbits;
+
+public:
+    BitReader(const unsigned char* data, size_t n) : p(data), end(data + n), acc(0), nbits(0) {}
+
+    // ֤ 56 λ
+    void refill() {
+        if (end - p >= 8) {
+            uint64_t w = 0;
+            for (int i = 0; i < 8; ++i) w = (w << 8) | p[i];
+            acc |= w >> nbits;
+            p += (63 - nbits) >> 3;
+            nbits |= 56;
+            return;
+        }
+        while (nbits <= 56) {
+            if (p == end) {
+                nbits = 64;   // Ѷ꣺λΪ 0
+                return;
+            }
+            acc |= (uint64_t)(*p++) << (56 - nbits);
+            nbits += 8;
+        }
+    }
 
-    // 0
-    code->clear(depth);
-    buildCodeTable(node->left, code, depth + 1);
+    uint32_t peek(int k) const { return (uint32_t)(acc >> (64 - k)); }
+    void consume(int k) { acc <<= k; nbits -= k; }
+};
 
-    // 1
-    code->set(depth);
-    buildCodeTable(node->right, code, depth + 1);
+//  n д outǷַ false
+bool huffDecode(const HuffCodec& hc, BitReader& br, unsigned char* out, size_t n) {
+    size_t i = 0;
+    while (n - i >= 12) {
+        br.refill();
+        for (int k = 0; k < 4; ++k) {   // 56 λ㹻 4 Σÿ 12 λ
+            uint32_t e = hc.lut[br.peek(HUFF_MAX_LEN)];
+            int cnt = (e >> 24) & 3;
+            if (cnt == 0) return false;
+            out[i] = (unsigned char)e;
+            out[i + 1] = (unsigned char)(e >> 8);
+            out[i + 2] = (unsigned char)(e >> 16);
+            i += cnt;
+            br.consume(e >> 26);
+        }
+    }
+    while (i < n) {
+        br.refill();
+        uint16_t e = hc.single[br.peek(HUFF_MAX_LEN)];
+        if ((e & 15) == 0) return false;
+        out[i++] = (unsigned char)(e >> 4);
+        br.consume(e & 15);
+    }
+    return true;
 }
 
 // ========================
-// 4. ȡݽıȷĸ
+// 5. ֿѹÿ̳߳زУ֧ʣ
+// ========================
+// ļʽΪСˣ
+//   "HUB1" | С4 ֽڣ
+//     n128 ֽ볤ÿֽ 4 λ볤+ λѹСԭʱԭ
+//     nƫƣ8 ֽڣ| ѹȣ4 ֽڣ| ԭʼȣ4 ֽڣ
+//   ļβƫƣ8 ֽڣ|  n8 ֽڣ| ԭʼܳ8 ֽڣ| "HUBX"
+const char HUB_MAGIC[4] = {'H', 'U', 'B', '1'};
+const char HUB_TAIL_MAGIC[4] = {'H', 'U', 'B', 'X'};
+const uint32_t HUB_BLOCK = 128 * 1024;
+const int HUB_LEN_BYTES = HUFF_SYMS / 2;
+const int HUB_TAIL_BYTES = 28;
+
+struct HubIndexEntry {
+    uint64_t offset;
+    uint32_t csize;
+    uint32_t rsize;
+};
+
+inline void putLE(unsigned char* p, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+inline uint64_t getLE(const unsigned char* p, int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+// ̶̳߳߳أparallelFor  [0, n) ַ̣߳ߣȴ
+class ThreadPool {
+private:
+    vector<thread> workers;
+    mutex mtx;
+    condition_variable wake, done;
+    const function<void(size_t)>* job;
+    size_t total;
+    atomic<size_t> next;
+    int busy;
+    uint64_t round;
+    bool stop;
+
+    void drain() {
+        for (size_t i; (i = next.fetch_add(1)) < total;) (*job)(i);
+    }
+
+    void loop() {
+        uint64_t seen = 0;
+        while (true) {
+            {
+                unique_lock<mutex> lk(mtx);
+                wake.wait(lk, [&] { return stop || round != seen; });
+                if (stop) return;
+                seen = round;
+            }
+            drain();
+            lock_guard<mutex> lk(mtx);
+            if (--busy == 0) done.notify_one();
+        }
+    }
+
+public:
+    explicit ThreadPool(int threads = 0) : job(nullptr), total(0), next(0), busy(0), round(0), stop(false) {
+        if (threads <= 0) threads = (int)max(1u, thread::hardware_concurrency());
+        for (int t = 1; t < threads; ++t) workers.emplace_back(&ThreadPool::loop, this);
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lk(mtx);
+            stop = true;
+        }
+        wake.notify_all();
+        for (auto& w : workers) w.join();
+    }
+
+    int size() const { return (int)workers.size() + 1; }
+
+    void parallelFor(size_t n, const function<void(size_t)>& fn) {
+        {
+            lock_guard<mutex> lk(mtx);
+            job = &fn;
+            total = n;
+            next = 0;
+            busy = (int)workers.size();
+            round++;
+        }
+        wake.notify_all();
+        drain();
+        unique_lock<mutex> lk(mtx);
+        done.wait(lk, [&] { return busy == 0; });
+    }
+};
+
+// ѹ鵽 outдѹ󳤶
+size_t hubCompressBlock(const unsigned char* src, size_t n, vector<unsigned char>& out) {
+    uint64_t freq[HUFF_SYMS] = {0};
+    countByteFreq(src, n, freq, 1);
+    HuffCodec hc;
+    hc.build(freq, false);
+
+    out.clear();
+    out.reserve(n + HUB_LEN_BYTES + 8);
+    for (int i = 0; i < HUB_LEN_BYTES; ++i) {
+        out.push_back((unsigned char)(hc.len[2 * i] | (hc.len[2 * i + 1] << 4)));
+    }
+    BitWriter bw(out);
+    for (size_t i = 0; i < n; ++i) bw.put(hc.code[src[i]]);
+    bw.finish();
+
+    if (out.size() >= n) out.assign(src, src + n);   // ѹԭ
+    return out.size();
+}
+
+bool hubDecompressBlock(const unsigned char* src, size_t csize, unsigned char* dst, size_t rsize) {
+    if (csize == rsize) {
+        memcpy(dst, src, rsize);
+        return true;
+    }
+    if (csize < (size_t)HUB_LEN_BYTES) return false;
+    uint8_t lens[HUFF_SYMS];
+    for (int i = 0; i < HUB_LEN_BYTES; ++i) {
+        lens[2 * i] = src[i] & 15;
+        lens[2 * i + 1] = src[i] >> 4;
+    }
+    HuffCodec hc;
+    if (!hc.fromLengths(lens)) return false;
+    BitReader br(src + HUB_LEN_BYTES, csize - HUB_LEN_BYTES);
+    return huffDecode(hc, br, dst, rsize);
+}
+
+// ʽѹÿζһ飨߳  4ѹдڴռļС޹
+bool hubCompress(istream& in, ostream& out, ThreadPool& pool, uint32_t blockSize = HUB_BLOCK) {
+    unsigned char header[8];
+    memcpy(header, HUB_MAGIC, 4);
+    putLE(header + 4, blockSize, 4);
+    out.write((const char*)header, sizeof(header));
+
+    size_t batch = (size_t)pool.size() * 4;
+    vector<unsigned char> raw(batch * blockSize);
+    vector<size_t> rawLen(batch);
+    vector<vector<unsigned char>> packed(batch);
+    vector<HubIndexEntry> index;
+    uint64_t offset = sizeof(header), total = 0;
+
+    while (true) {
+        size_t nb = 0;
+        while (nb < batch) {
+            in.read((char*)raw.data() + nb * blockSize, blockSize);
+            rawLen[nb] = (size_t)in.gcount();
+            if (rawLen[nb] == 0) break;
+            ++nb;
+            if (rawLen[nb - 1] < blockSize) break;
+        }
+        if (nb == 0) break;
+        pool.parallelFor(nb, [&](size_t b) {
+            hubCompressBlock(raw.data() + b * blockSize, rawLen[b], packed[b]);
+        });
+        for (size_t b = 0; b < nb; ++b) {
+            out.write((const char*)packed[b].data(), packed[b].size());
+            index.push_back({offset, (uint32_t)packed[b].size(), (uint32_t)rawLen[b]});
+            offset += packed[b].size();
+            total += rawLen[b];
+        }
+        if (rawLen[nb - 1] < blockSize) break;
+    }
+
+    vector<unsigned char> tail(index.size() * 16 + HUB_TAIL_BYTES);
+    for (size_t i = 0; i < index.size(); ++i) {
+        putLE(&tail[16 * i], index[i].offset, 8);
+        putLE(&tail[16 * i + 8], index[i].csize, 4);
+        putLE(&tail[16 * i + 12], index[i].rsize, 4);
+    }
+    unsigned char* t = &tail[16 * index.size()];
+    putLE(t, offset, 8);
+    putLE(t + 8, index.size(), 8);
+    putLE(t + 16, total, 8);
+    memcpy(t + 24, HUB_TAIL_MAGIC, 4);
+    out.write((const char*)tail.data(), tail.size());
+    return (bool)out;
+}
+
+// ʶȡʱֻļͷβ O(1) λ
+class HubReader {
+private:
+    istream& in;
+    uint32_t blockSize;
+    uint64_t total;
+    vector<HubIndexEntry> index;
+    bool valid;
+
+public:
+    HubReader(istream& is) : in(is), blockSize(0), total(0), valid(false) {
+        unsigned char header[8], tail[HUB_TAIL_BYTES];
+        if (!in.read((char*)header, 8) || memcmp(header, HUB_MAGIC, 4) != 0) return;
+        blockSize = (uint32_t)getLE(header + 4, 4);
+        in.seekg(0, ios::end);
+        uint64_t fileSize = (uint64_t)in.tellg();
+        if (blockSize == 0 || fileSize < 8 + HUB_TAIL_BYTES) return;
+        in.seekg(fileSize - HUB_TAIL_BYTES);
+        if (!in.read((char*)tail, HUB_TAIL_BYTES) || memcmp(tail + 24, HUB_TAIL_MAGIC, 4) != 0) return;
+        uint64_t indexOff = getLE(tail, 8), n = getLE(tail + 8, 8);
+        total = getLE(tail + 16, 8);
+        // ޶ n  indexOff ķΧn * 16 Ų𻵵βҲᴥ
+        if (indexOff > fileSize || n > (fileSize - 8 - HUB_TAIL_BYTES) / 16) return;
+        if (indexOff + n * 16 + HUB_TAIL_BYTES != fileSize) return;
+
+        vector<unsigned char> raw(n * 16);
+        in.seekg(indexOff);
+        if (!in.read((char*)raw.data(), raw.size())) return;
+        index.resize(n);
+        for (uint64_t i = 0; i < n; ++i) {
+            index[i] = {getLE(&raw[16 * i], 8), (uint32_t)getLE(&raw[16 * i + 8], 4),
+                        (uint32_t)getLE(&raw[16 * i + 12], 4)};
+            if (index[i].offset > indexOff || index[i].csize > indexOff - index[i].offset ||
+                index[i].rsize > blockSize) {
+                index.clear();
+                return;
+            }
+        }
+        valid = true;
+    }
+
+    bool ok() const { return valid; }
+    size_t blockCount() const { return index.size(); }
+    uint32_t getBlockSize() const { return blockSize; }
+    uint64_t rawSize() const { return total; }
+    const HubIndexEntry& entry(size_t i) const { return index[i]; }
+
+    //  i ѹݣ룩
+    bool readPacked(size_t i, vector<unsigned char>& buf) {
+        buf.resize(index[i].csize);
+        in.clear();
+        in.seekg(index[i].offset);
+        return (bool)in.read((char*)buf.data(), buf.size());
+    }
+
+    //  i 
+    bool readBlock(size_t i, vector<unsigned char>& out) {
+        vector<unsigned char> buf;
+        if (!readPacked(i, buf)) return false;
+        out.resize(index[i].rsize);
+        return hubDecompressBlock(buf.data(), buf.size(), out.data(), out.size());
+    }
+};
+
+bool hubDecompress(istream& in, ostream& out, ThreadPool& pool) {
+    HubReader reader(in);
+    if (!reader.ok()) return false;
+    size_t batch = (size_t)pool.size() * 4;
+    vector<vector<unsigned char>> packed(batch);
+    vector<unsigned char> raw(batch * reader.getBlockSize());
+    for (size_t first = 0; first < reader.blockCount(); first += batch) {
+        size_t nb = min(batch, reader.blockCount() - first);
+        for (size_t b = 0; b < nb; ++b) {
+            if (!reader.readPacked(first + b, packed[b])) return false;
+        }
+        atomic<bool> ok(true);
+        pool.parallelFor(nb, [&](size_t b) {
+            const HubIndexEntry& e = reader.entry(first + b);
+            if (!hubDecompressBlock(packed[b].data(), e.csize, raw.data() + b * reader.getBlockSize(), e.rsize))
+                ok = false;
+        });
+        if (!ok) return false;
+        for (size_t b = 0; b < nb; ++b) {
+            out.write((const char*)raw.data() + b * reader.getBlockSize(), reader.entry(first + b).rsize);
+        }
+    }
+    return (bool)out;
+}
+
+// ========================
+// 6. ȡݽıȷĸ
 // ========================
 string getSpeechText() {
     return
@@ -140,101 +1462,336 @@ string getSpeechText() {
 
 // ͳ26ĸƵΣִСд
 vector<int> countLetterFreq(const string& text) {
+    uint64_t hist[HUFF_SYMS] = {0};
+    countByteFreq((const unsigned char*)text.data(), text.size(), hist);
     vector<int> freq(26, 0);
-    for (char c : text) {
-        if (isalpha(c)) {
-            freq[tolower(c) - 'a']++;
-        }
-    }
+    for (int i = 0; i < 26; ++i) freq[i] = (int)(hist['a' + i] + hist['A' + i]);
     return freq;
 }
 
 // ========================
-// 5. 
+// 7. ׼
 // ========================
-int main() {
-    // 1. ͳƵ
-    string speech = getSpeechText();
-    vector<int> freq = countLetterFreq(speech);
+template <typename F>
+double timeMs(F f) {
+    auto start = chrono::high_resolution_clock::now();
+    f();
+    auto end = chrono::high_resolution_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void benchBitmap(Rank nbits, Rank ops) {
+    mt19937 gen(42);
+    uniform_int_distribution<Rank> dist(0, nbits - 1);
+    vector<Rank> ids(ops), probes(ops);
+    for (Rank i = 0; i < ops; ++i) ids[i] = dist(gen);
+    for (Rank i = 0; i < ops; ++i) probes[i] = dist(gen);
+
+    ByteBitmap oldA(nbits), oldB(nbits);
+    Bitmap newA(nbits), newB(nbits);
+    long long oldHits = 0, newHits = 0;
 
-    // 2. Ҷӽڵ㲢ȶ
-    priority_queue<BinTree*, vector<BinTree*>, Compare> pq;
-    for (int i = 0; i < 26; ++i) {
-        if (freq[i] > 0) {
-            pq.push(new BinTree('a' + i, freq[i]));
+    cout << fixed << setprecision(2);
+    cout << "=== Bitmap benchmark: " << nbits << " bits, " << ops << " ops ===\n";
+    cout << "  operation      ByteBitmap(ms)   Bitmap(ms)\n";
+
+    // ״д뺬ȱҳ¶ظ 3 ȡСֵ
+    double o = 1e30, n = 1e30;
+    for (int rep = 0; rep < 3; ++rep) {
+        ByteBitmap bo(nbits);
+        Bitmap bn(nbits);
+        o = min(o, timeMs([&] { for (Rank k : ids) bo.set(k); }));
+        n = min(n, timeMs([&] { for (Rank k : ids) bn.set(k); }));
+    }
+    for (Rank k : ids) { oldA.set(k); newA.set(k); }
+    cout << "  set          " << setw(14) << o << setw(13) << n << "\n";
+
+    for (Rank k : probes) { oldB.set(k); newB.set(k); }
+
+    o = timeMs([&] { for (Rank k : probes) oldHits += oldA.test(k); });
+    n = timeMs([&] { for (Rank k : probes) newHits += newA.test(k); });
+    cout << "  test         " << setw(14) << o << setw(13) << n
+         << (oldHits == newHits ? "" : "  [MISMATCH]") << "\n";
+
+    Rank strBits = min(nbits, (Rank)1 << 24);
+    char* so = nullptr;
+    char* sn = nullptr;
+    o = timeMs([&] { so = oldA.bits2string(strBits); });
+    n = timeMs([&] { sn = newA.bits2string(strBits); });
+    // λͬԭÿֽڸλǰλ˶
+    bool same = true;
+    for (Rank i = 0; i < strBits && same; ++i) same = (so[i] == '1') == newA.test(i);
+    cout << "  bits2string  " << setw(14) << o << setw(13) << n << (same ? "" : "  [MISMATCH]") << "\n";
+    delete[] so;
+    delete[] sn;
+
+    o = timeMs([&] { for (Rank i = 0; i < nbits; ++i) if (oldB.test(i)) oldA.set(i); });
+    n = timeMs([&] { newA.orWith(newB); });
+    cout << "  union        " << setw(14) << o << setw(13) << n << "\n";
+
+    // rank/select ֻʵṩ
+    Rank q = min(ops, (Rank)1000000);
+    long long acc = 0;
+    double tr = timeMs([&] { for (Rank i = 0; i < q; ++i) acc += newA.rank(probes[i]); });
+    double ts = timeMs([&] {
+        for (Rank i = 0; i < q; ++i) acc += newA.select(probes[i] % newA.size());
+    });
+    bool consistent = true;
+    for (Rank i = 0; i < 1000 && consistent; ++i) {
+        Rank j = probes[i] % newA.size();
+        consistent = newA.rank(newA.select(j)) == j;
+    }
+    cout << "  rank  x" << q << ": " << tr << " ms\n";
+    cout << "  select x" << q << ": " << ts << " ms" << (consistent ? "" : "  [MISMATCH]") << "\n";
+
+    // ԭ _sz ظ set ʱۼӣƫ
+    cout << "  population: ByteBitmap.size() = " << oldA.size()
+         << ", Bitmap.size() = " << newA.size()
+         << ", actual = " << newA.rank(nbits) << "\n";
+}
+
+// ϡۼ IDclusters ֲ [0, 2^31) ڣÿһһɢ 64K 
+vector<Rank> clusteredIds(mt19937& gen, int clusters, int perCluster) {
+    uniform_int_distribution<Rank> base(0, INT_MAX - 70000);
+    uniform_int_distribution<Rank> spread(0, 65535);
+    vector<Rank> ids;
+    for (int c = 0; c < clusters; ++c) {
+        Rank b = base(gen);
+        for (int i = 0; i < perCluster / 2; ++i) ids.push_back(b + i);
+        for (int i = perCluster / 2; i < perCluster; ++i) ids.push_back(b + spread(gen));
+    }
+    return ids;
+}
+
+void benchRoaring(const char* path) {
+    mt19937 gen(42);
+    vector<Rank> idsA = clusteredIds(gen, 200, 5000);
+    vector<Rank> idsB = clusteredIds(gen, 200, 5000);
+    for (size_t i = 0; i < idsB.size(); i += 2) idsB[i] = idsA[i];   // һ뽻
+
+    Bitmap denseA(64), denseB(64);
+    RoaringBitmap ra, rb;
+    double td = timeMs([&] { for (Rank k : idsA) denseA.set(k); });
+    double tr = timeMs([&] { for (Rank k : idsA) ra.add((uint32_t)k); });
+    for (Rank k : idsB) { denseB.set(k); rb.add((uint32_t)k); }
+
+    cout << fixed << setprecision(2);
+    cout << "=== RoaringBitmap vs Bitmap: " << idsA.size() << " clustered ids in [0, 2^31) ===\n";
+    cout << "  build        Bitmap " << setw(8) << td << " ms   Roaring " << setw(8) << tr << " ms\n";
+    size_t before = ra.sizeInBytes();
+    ra.runOptimize();
+    rb.runOptimize();
+    cout << "  memory       Bitmap " << setw(10) << denseA.byteSize() / 1024 << " KB"
+         << "   Roaring " << before / 1024 << " KB (runOptimize: " << ra.sizeInBytes() / 1024 << " KB)\n";
+
+    RoaringBitmap rAnd, rOr;
+    Bitmap dAnd(denseA), dOr(denseA);
+    double tdAnd = timeMs([&] { dAnd.andWith(denseB); });
+    double tdOr = timeMs([&] { dOr.orWith(denseB); });
+    double trAnd = timeMs([&] { rAnd = ra & rb; });
+    double trOr = timeMs([&] { rOr = ra | rb; });
+    bool same = rAnd.cardinality() == (uint64_t)dAnd.size() && rOr.cardinality() == (uint64_t)dOr.size();
+    cout << "  AND          Bitmap " << setw(8) << tdAnd << " ms   Roaring " << setw(8) << trAnd << " ms\n";
+    cout << "  OR           Bitmap " << setw(8) << tdOr << " ms   Roaring " << setw(8) << trOr << " ms"
+         << (same ? "" : "  [MISMATCH]") << "\n";
+
+    // л mmap ֱӳڴϲѯ
+    {
+        ofstream out(path, ios::binary);
+        if (!out || !ra.serialize(out)) {
+            cout << "[Error] Cannot write " << path << "\n";
+            return;
         }
     }
+    MappedFile mf;
+    if (!mf.open(path)) {
+        cout << "[Error] Cannot map " << path << "\n";
+        return;
+    }
+    RoaringView view(mf.data(), mf.size());
+    long long hits = 0;
+    double tv = timeMs([&] {
+        for (Rank k : idsA) hits += view.contains((uint32_t)k);
+        for (Rank k : idsB) hits += view.contains((uint32_t)k);
+    });
+    long long expect = 0;
+    for (Rank k : idsA) expect += denseA.test(k);
+    for (Rank k : idsB) expect += denseA.test(k);
+    cout << "  mmap view    " << mf.size() / 1024 << " KB file, " << idsA.size() + idsB.size()
+         << " lookups " << tv << " ms" << (view.ok() && hits == expect ? "" : "  [MISMATCH]") << "\n";
+}
+
+// ֿļڴֱʱѹѹų I/O
+bool benchHub(const char* path, int threads) {
+    ifstream fin(path, ios::binary);
+    if (!fin) {
+        cout << "[Error] Cannot open " << path << "\n";
+        return false;
+    }
+    vector<unsigned char> data((istreambuf_iterator<char>(fin)), istreambuf_iterator<char>());
+    size_t nb = (data.size() + HUB_BLOCK - 1) / HUB_BLOCK;
+    auto blockLen = [&](size_t b) { return min<size_t>(HUB_BLOCK, data.size() - b * HUB_BLOCK); };
+    double mb = data.size() / 1048576.0;
 
-    // 3.  Huffman 
-    while (pq.size() > 1) {
-        BinTree* left = pq.top(); pq.pop();
-        BinTree* right = pq.top(); pq.pop();
-        BinTree* parent = new BinTree(left->freq + right->freq, left, right);
-        pq.push(parent);
+    cout << fixed << setprecision(2);
+    cout << "=== Block Huffman benchmark: " << path << " (" << mb << " MB, " << nb << " blocks) ===\n";
+    vector<int> counts = {1};
+    int maxThreads = threads > 0 ? threads : (int)max(1u, thread::hardware_concurrency());
+    if (maxThreads > 1) counts.push_back(maxThreads);
+
+    vector<vector<unsigned char>> packed(nb);
+    vector<unsigned char> back(data.size());
+    for (int t : counts) {
+        ThreadPool pool(t);
+        double tc = timeMs([&] {
+            pool.parallelFor(nb, [&](size_t b) {
+                hubCompressBlock(data.data() + b * HUB_BLOCK, blockLen(b), packed[b]);
+            });
+        });
+        atomic<bool> ok(true);
+        double td = timeMs([&] {
+            pool.parallelFor(nb, [&](size_t b) {
+                if (!hubDecompressBlock(packed[b].data(), packed[b].size(), back.data() + b * HUB_BLOCK, blockLen(b)))
+                    ok = false;
+            });
+        });
+        size_t csize = 8 + HUB_TAIL_BYTES + 16 * nb;
+        for (auto& p : packed) csize += p.size();
+        cout << "  threads " << setw(2) << t << ": compress " << setw(8) << mb / (tc / 1000) << " MB/s"
+             << ", decompress " << setw(8) << mb / (td / 1000) << " MB/s"
+             << ", ratio " << (double)csize / max<size_t>(data.size(), 1)
+             << (ok && back == data ? "" : "  [MISMATCH]") << "\n";
     }
 
-    BinTree* root = pq.empty() ? nullptr : pq.top();
+    // ʣдʽֱӽ
+    stringstream ss;
+    ThreadPool pool(maxThreads);
+    stringstream src(string(data.begin(), data.end()));
+    hubCompress(src, ss, pool);
+    HubReader reader(ss);
+    mt19937 gen(42);
+    int probes = (int)min<size_t>(nb, 100);
+    bool same = reader.ok();
+    vector<unsigned char> block;
+    double tr = timeMs([&] {
+        for (int i = 0; i < probes && same; ++i) {
+            size_t b = gen() % nb;
+            same = reader.readBlock(b, block) && equal(block.begin(), block.end(), data.begin() + b * HUB_BLOCK);
+        }
+    });
+    cout << "  random access: " << probes << " blocks, " << (probes ? tr / probes : 0.0) << " ms/block"
+         << (same ? "" : "  [MISMATCH]") << "\n";
+    return true;
+}
 
-    // 4. ɱ
-    if (root) {
-        Bitmap* code = new Bitmap(100);
-        buildCodeTable(root, code, 0);
-        delete code;
+// ========================
+// 8. 
+// ========================
+// ÷exp2 -c <> <>   128 KB ֿ鲢ѹļ
+//       exp2 -d <> <>  ѹ
+//       exp2 -b <> [߳] ѹ/ѹѹʻ׼
+//       exp2 -bitmap [λ]    Bitmap ׼
+//       exp2 -roaring [ļ]   RoaringBitmap ׼ԣл mmap ѯ
+//       exp2                   ݽıʾ
+int main(int argc, char* argv[]) {
+    if (argc == 4 && (strcmp(argv[1], "-c") == 0 || strcmp(argv[1], "-d") == 0)) {
+        ifstream fin(argv[2], ios::binary);
+        ofstream fout(argv[3], ios::binary);
+        if (!fin || !fout) {
+            cout << "[Error] Cannot open " << (!fin ? argv[2] : argv[3]) << "\n";
+            return 1;
+        }
+        ThreadPool pool;
+        auto start = chrono::high_resolution_clock::now();
+        bool ok = argv[1][1] == 'c' ? hubCompress(fin, fout, pool)
+                                    : hubDecompress(fin, fout, pool);
+        fout.flush();
+        double sec = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+        if (!ok) {
+            cout << "[Error] " << (argv[1][1] == 'c' ? "Compression" : "Decompression") << " failed.\n";
+            return 1;
+        }
+        fin.clear();
+        fin.seekg(0, ios::end);
+        double inBytes = (double)fin.tellg(), outBytes = (double)fout.tellp();
+        double rawBytes = argv[1][1] == 'c' ? inBytes : outBytes;
+        cout << fixed << setprecision(2) << inBytes / 1048576 << " MB -> " << outBytes / 1048576
+             << " MB, " << rawBytes / 1048576 / max(sec, 1e-9) << " MB/s, ratio "
+             << (argv[1][1] == 'c' ? outBytes / max(inBytes, 1.0) : inBytes / max(outBytes, 1.0)) << "\n";
+        return 0;
+    }
+    if (argc >= 3 && strcmp(argv[1], "-b") == 0) {
+        return benchHub(argv[2], argc >= 4 ? atoi(argv[3]) : 0) ? 0 : 1;
+    }
+    if (argc >= 2 && strcmp(argv[1], "-bitmap") == 0) {
+        Rank nbits = argc >= 3 ? atoi(argv[2]) : (1 << 26);
+        if (nbits <= 0) nbits = 1 << 26;
+        benchBitmap(nbits, min(nbits, (Rank)1 << 24));
+        return 0;
+    }
+    if (argc >= 2 && strcmp(argv[1], "-roaring") == 0) {
+        benchRoaring(argc >= 3 ? argv[2] : "roaring.bin");
+        return 0;
     }
 
-    // 5. Եʽб
+    // 1. ͳƵ
+    string speech = getSpeechText();
+    vector<int> freq = countLetterFreq(speech);
+
+    // 2. ĸ볤 Huffman óȡʽʽ
+    uint64_t letterFreq[HUFF_SYMS] = {0};
+    for (int i = 0; i < 26; ++i) letterFreq['a' + i] = freq[i];
+    HuffCodec hc;
+    hc.build(letterFreq);
+
+    // 3. Եʽб룬֤
     vector<string> words = {"dream", "freedom", "king", "hope"};
 
     for (const string& word : words) {
         cout << "\nEncoding word: \"" << word << "\"\n";
-        Bitmap* full = new Bitmap(500);
-        int pos = 0;
+        vector<unsigned char> bits;
+        BitWriter bw(bits);
+        string full;
         bool valid = true;
 
         for (char c : word) {
-            c = tolower(c);
-            if (huffTable.find(c) == huffTable.end()) {
+            unsigned char u = (unsigned char)tolower(c);
+            if (hc.len[u] == 0) {
                 cout << "[Error] Letter '" << c << "' not found in Huffman table.\n";
                 valid = false;
                 break;
             }
-
-            Bitmap* code = huffTable[c];
-            // ñʵʳȣ趨λ +1
-            int len = 0;
-            for (int i = 0; i < 100; ++i) {
-                if (code->test(i)) len = i + 1;
-            }
-
-            // 
-            for (int i = 0; i < len; ++i) {
-                if (code->test(i)) {
-                    full->set(pos);
-                } else {
-                    full->clear(pos);
-                }
-                pos++;
-            }
-
-            // ӡĸ
-            char* s = code->bits2string(len);
-            cout << c << ": " << s << endl;
-            delete[] s;
+            bw.put(hc.code[u]);
+            string s = codeToString(hc.code[u]);
+            cout << (char)u << ": " << s << endl;
+            full += s;
         }
+        bw.finish();
 
         if (valid) {
-            char* result = full->bits2string(pos);
-            cout << "Full code: " << result << endl;
-            delete[] result;
+            cout << "Full code: " << full << endl;
+            string decoded(word.size(), '\0');
+            BitReader br(bits.data(), bits.size());
+            huffDecode(hc, br, (unsigned char*)&decoded[0], decoded.size());
+            cout << "Decoded: " << decoded << endl;
         }
-        delete full;
     }
 
-    // 6. ڴ
-    for (auto& kv : huffTable) {
-        delete kv.second;
-    }
-    // ע⣺BinTree ڵδͷţҵɽܣʵĿӦݹ delete
+    // 4. ݽֽڱ루ո񡢱㣩һ
+    uint64_t byteFreq[HUFF_SYMS] = {0};
+    for (char c : speech) byteFreq[(unsigned char)c]++;
+    HuffCodec full;
+    full.build(byteFreq);
+    vector<unsigned char> bits;
+    BitWriter bw(bits);
+    for (char c : speech) bw.put(full.code[(unsigned char)c]);
+    bw.finish();
+
+    string back(speech.size(), '\0');
+    BitReader br(bits.data(), bits.size());
+    bool ok = huffDecode(full, br, (unsigned char*)&back[0], back.size()) && back == speech;
+    cout << "\nSpeech: " << speech.size() << " bytes -> " << bits.size() << " bytes, round trip "
+         << (ok ? "OK" : "FAILED") << endl;
 
     return 0;
 }
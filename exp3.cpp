@@ -7,241 +7,1765 @@
 #include <set>
 #include <map>
 #include <unordered_set>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <fstream>
+#include <iterator>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
 // ========================
-// ͨͼࣨڽӾ
+// CSR ѹϡд洢
+// ========================
+struct Edge {
+    int u, v, w;
+};
+
+// ֻļӳ䣺POSIX  mmapƽ̨ڴ
+class MappedFile {
+private:
+    const unsigned char* addr;
+    size_t len;
+    vector<unsigned char> buf;
+    bool mapped;
+
+public:
+    MappedFile() : addr(nullptr), len(0), mapped(false) {}
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const char* path) {
+        close();
+#if defined(_WIN32)
+        ifstream in(path, ios::binary);
+        if (!in) return false;
+        buf.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        addr = buf.data();
+        len = buf.size();
+        return true;
+#else
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+        len = (size_t)st.st_size;
+        if (len == 0) { ::close(fd); return true; }
+        void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) { len = 0; return false; }
+        addr = (const unsigned char*)p;
+        mapped = true;
+        return true;
+#endif
+    }
+
+    void close() {
+#if !defined(_WIN32)
+        if (mapped) munmap((void*)addr, len);
+#endif
+        mapped = false;
+        addr = nullptr;
+        len = 0;
+        buf.clear();
+    }
+
+    const unsigned char* data() const { return addr; }
+    size_t size() const { return len; }
+};
+
+// ļ32 ֽͷ + offset[n+1]int64+ target[m]int32뵽 8 ֽڣ+ weight[m]int32
+struct CSRHeader {
+    char magic[4];
+    uint32_t version;
+    int64_t n;
+    int64_t m;
+    uint64_t reserved;
+};
+const char CSR_MAGIC[4] = {'C', 'S', 'R', '1'};
+
+static size_t alignUp8(size_t x) { return (x + 7) & ~(size_t)7; }
+
+// offset[u] .. offset[u+1] Ϊ u ڱ target / weight е䣬ھӰ
+// ָд洢ֱָ mmap ӳĿļֻͼ߷䣩
+struct CSR {
+    int n;
+    const int64_t* offset;   // n + 1 ɳ 2^31 64 λ
+    const int* target;
+    const int* weight;
+
+    CSR() : n(0), offsetBuf(1, 0) { bindOwned(); }
+    CSR(const CSR& o) : n(o.n), offsetBuf(o.offsetBuf), targetBuf(o.targetBuf), weightBuf(o.weightBuf), file(o.file) {
+        bindFrom(o);
+    }
+    CSR& operator=(const CSR& o) {
+        if (this == &o) return *this;
+        n = o.n;
+        offsetBuf = o.offsetBuf;
+        targetBuf = o.targetBuf;
+        weightBuf = o.weightBuf;
+        file = o.file;
+        bindFrom(o);
+        return *this;
+    }
+    // ƶʱ vector ĻתƣָȻЧ
+    CSR(CSR&&) = default;
+    CSR& operator=(CSR&&) = default;
+
+    int64_t edgeCount() const { return offset[n]; }
+    int64_t degree(int u) const { return offset[u + 1] - offset[u]; }
+    bool isMapped() const { return file != nullptr; }
+
+    // һ˼ͰͰڰյظ߱һεȨأ
+    // Ȩ <= 0 ıΪڣԭڽӾһ£
+    void build(int vertices, const vector<Edge>& edges, bool undirected) {
+        vector<int64_t>& off = offsetBuf;
+        vector<int>& tgt = targetBuf;
+        vector<int>& wt = weightBuf;
+        n = vertices;
+        off.assign(n + 1, 0);
+        for (const Edge& e : edges) {
+            off[e.u + 1]++;
+            if (undirected && e.u != e.v) off[e.v + 1]++;
+        }
+        for (int u = 0; u < n; ++u) off[u + 1] += off[u];
+        tgt.resize(off[n]);
+        wt.resize(off[n]);
+
+        vector<int64_t> pos(off.begin(), off.end() - 1);
+        for (const Edge& e : edges) {
+            tgt[pos[e.u]] = e.v;
+            wt[pos[e.u]++] = e.w;
+            if (undirected && e.u != e.v) {
+                tgt[pos[e.v]] = e.u;
+                wt[pos[e.v]++] = e.w;
+            }
+        }
+
+        // Ͱȶԭѹдָ벻ָ룩СͰò
+        vector<pair<int, int>> row;
+        int64_t out = 0;
+        for (int u = 0; u < n; ++u) {
+            int64_t lo = off[u], hi = off[u + 1];
+            if (hi - lo <= 32) {
+                for (int64_t i = lo + 1; i < hi; ++i) {
+                    int t = tgt[i], w = wt[i];
+                    int64_t j = i;
+                    for (; j > lo && tgt[j - 1] > t; --j) {
+                        tgt[j] = tgt[j - 1];
+                        wt[j] = wt[j - 1];
+                    }
+                    tgt[j] = t;
+                    wt[j] = w;
+                }
+            } else {
+                row.clear();
+                for (int64_t i = lo; i < hi; ++i) row.push_back({tgt[i], wt[i]});
+                stable_sort(row.begin(), row.end(),
+                            [](const pair<int, int>& a, const pair<int, int>& b) { return a.first < b.first; });
+                for (int64_t i = lo; i < hi; ++i) {
+                    tgt[i] = row[i - lo].first;
+                    wt[i] = row[i - lo].second;
+                }
+            }
+            off[u] = out;
+            for (int64_t i = lo; i < hi; ++i) {
+                if (i + 1 < hi && tgt[i + 1] == tgt[i]) continue;
+                if (wt[i] <= 0) continue;
+                tgt[out] = tgt[i];
+                wt[out++] = wt[i];
+            }
+        }
+        off[n] = out;
+        tgt.resize(out);
+        wt.resize(out);
+        tgt.shrink_to_fit();
+        wt.shrink_to_fit();
+        file.reset();
+        bindOwned();
+    }
+
+    // дգ load ֱӳ
+    bool save(const char* path) const {
+        ofstream out(path, ios::binary);
+        if (!out) return false;
+        CSRHeader h;
+        memcpy(h.magic, CSR_MAGIC, 4);
+        h.version = 1;
+        h.n = n;
+        h.m = edgeCount();
+        h.reserved = 0;
+        static const char zeros[8] = {0};
+        size_t tgtBytes = (size_t)h.m * sizeof(int);
+        out.write((const char*)&h, sizeof(h));
+        out.write((const char*)offset, (streamsize)((n + 1) * sizeof(int64_t)));
+        out.write((const char*)target, (streamsize)tgtBytes);
+        out.write(zeros, (streamsize)(alignUp8(tgtBytes) - tgtBytes));
+        out.write((const char*)weight, (streamsize)tgtBytes);
+        return (bool)out;
+    }
+
+    // ӳļֱָӳڴ棬ʱֻȡҳ档
+    // ˳ɨһ O(m)ƫƵĿ궥 [0, n) ڡÿϸȨֵΪ
+    // Ȱļڴ˵öࡣҪʣ validate()
+    bool load(const char* path) {
+        shared_ptr<MappedFile> f = make_shared<MappedFile>();
+        if (!f->open(path) || f->size() < sizeof(CSRHeader)) return false;
+        CSRHeader h;
+        memcpy(&h, f->data(), sizeof(h));
+        if (memcmp(h.magic, CSR_MAGIC, 4) != 0 || h.version != 1 || h.n < 0 || h.n > INT_MAX || h.m < 0) return false;
+        if ((uint64_t)h.m > f->size() / (2 * sizeof(int))) return false;   // ֹ m * 4 
+        size_t offBytes = (size_t)(h.n + 1) * sizeof(int64_t), tgtBytes = (size_t)h.m * sizeof(int);
+        if (f->size() != sizeof(h) + offBytes + alignUp8(tgtBytes) + tgtBytes) return false;
+        const unsigned char* p = f->data() + sizeof(h);
+        const int64_t* off = (const int64_t*)p;
+        if (off[0] != 0 || off[h.n] != h.m) return false;
+        for (int64_t u = 0; u < h.n; ++u) {
+            if (off[u] > off[u + 1]) return false;
+        }
+        const int* tgt = (const int*)(p + offBytes);
+        const int* wgt = (const int*)(p + offBytes + alignUp8(tgtBytes));
+        for (int64_t u = 0; u < h.n; ++u) {
+            for (int64_t i = off[u]; i < off[u + 1]; ++i) {
+                if ((uint32_t)tgt[i] >= (uint64_t)h.n || wgt[i] <= 0) return false;
+                if (i > off[u] && tgt[i] <= tgt[i - 1]) return false;
+            }
+        }
+
+        n = (int)h.n;
+        offset = off;
+        target = tgt;
+        weight = wgt;
+        offsetBuf.clear();
+        targetBuf.clear();
+        weightBuf.clear();
+        file = f;
+        return true;
+    }
+
+    // У飺Ŀ궥 [0, n) ڡÿϸslotOf Ķһ㣩
+    // ȨֵΪÿ߶Ȩֵͬķߣ˫ͨ㷨ͼȱ߻Խ磩
+    // O(m log d)load ֻǰԴʱɵ÷ִ
+    bool validate() const {
+        for (int u = 0; u < n; ++u) {
+            for (int64_t i = offset[u]; i < offset[u + 1]; ++i) {
+                if (target[i] < 0 || target[i] >= n || weight[i] <= 0) return false;
+                if (i > offset[u] && target[i] <= target[i - 1]) return false;
+            }
+        }
+        for (int u = 0; u < n; ++u) {
+            for (int64_t i = offset[u]; i < offset[u + 1]; ++i) {
+                int64_t back = slotOf(target[i], u);
+                if (back < 0 || weight[back] != weight[i]) return false;
+            }
+        }
+        return true;
+    }
+
+    // ߱ÿֻһΣͼϼӱ
+    void appendEdges(vector<Edge>& edges) const {
+        for (int u = 0; u < n; ++u)
+            for (int64_t i = offset[u]; i < offset[u + 1]; ++i)
+                if (u <= target[i]) edges.push_back({u, target[i], weight[i]});
+    }
+
+    // ֲ (u, v) ڲλڷ -1
+    int64_t slotOf(int u, int v) const {
+        const int* first = target + offset[u];
+        const int* last = target + offset[u + 1];
+        const int* it = lower_bound(first, last, v);
+        return (it != last && *it == v) ? it - target : -1;
+    }
+
+    // (u, v) Ȩأڷ 0
+    int weightOf(int u, int v) const {
+        int64_t s = slotOf(u, v);
+        return s >= 0 ? weight[s] : 0;
+    }
+
+private:
+    vector<int64_t> offsetBuf;
+    vector<int> targetBuf;
+    vector<int> weightBuf;
+    shared_ptr<MappedFile> file;   // ǿʱָָӳڴ棬ͬһӳ
+
+    void bindOwned() {
+        offset = offsetBuf.data();
+        target = targetBuf.data();
+        weight = weightBuf.data();
+    }
+
+    void bindFrom(const CSR& o) {
+        if (file) {
+            offset = o.offset;
+            target = o.target;
+            weight = o.weight;
+        } else {
+            bindOwned();
+        }
+    }
+};
+
+// ========================
+// ·ѡȶУ
+// ========================
+enum class PQKind { BinaryHeap, QuaryHeap, RadixHeap };
+
+// ԶѣɳʱֱѹĿʱɵ÷Ŀ
+class BinaryHeapQueue {
+private:
+    priority_queue<pair<long long, int>, vector<pair<long long, int>>, greater<pair<long long, int>>> pq;
+
+public:
+    explicit BinaryHeapQueue(int) {}
+    bool empty() const { return pq.empty(); }
+    void push(int v, long long key) { pq.push({key, v}); }
+    pair<int, long long> pop() {
+        pair<long long, int> t = pq.top();
+        pq.pop();
+        return {t.second, t.first};
+    }
+};
+
+// λ 4 ѣͬһֻռһλdecrease-key ԭϸ
+class QuaryHeap {
+private:
+    vector<int> heap;
+    vector<int> pos;          //  heap е±꣬-1 ʾڶ
+    vector<long long> key;
+
+    void place(int i, int v) {
+        heap[i] = v;
+        pos[v] = i;
+    }
+
+    void siftUp(int i) {
+        int v = heap[i];
+        while (i > 0) {
+            int p = (i - 1) / 4;
+            if (key[heap[p]] <= key[v]) break;
+            place(i, heap[p]);
+            i = p;
+        }
+        place(i, v);
+    }
+
+    void siftDown(int i) {
+        int v = heap[i], n = (int)heap.size();
+        while (true) {
+            int c = 4 * i + 1;
+            if (c >= n) break;
+            int best = c, end = min(c + 4, n);
+            for (int j = c + 1; j < end; ++j)
+                if (key[heap[j]] < key[heap[best]]) best = j;
+            if (key[heap[best]] >= key[v]) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, v);
+    }
+
+public:
+    explicit QuaryHeap(int n) : pos(n, -1), key(n) {}
+    bool empty() const { return heap.empty(); }
+
+    void push(int v, long long k) {
+        if (pos[v] < 0) {
+            key[v] = k;
+            heap.push_back(v);
+            siftUp((int)heap.size() - 1);
+        } else if (k < key[v]) {
+            key[v] = k;
+            siftUp(pos[v]);
+        }
+    }
+
+    pair<int, long long> pop() {
+        int v = heap[0];
+        pos[v] = -1;
+        int last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            place(0, last);
+            siftDown(0);
+        }
+        return {v, key[v]};
+    }
+};
+
+// ѣҪ󵯳ļǸȨص Dijkstra 㣩
+// ϴελͰÿԪ౻·Ͱ 64 
+class RadixHeap {
+private:
+    vector<pair<uint64_t, int>> buckets[65];
+    uint64_t last;
+    size_t count;
+
+    static int bucketOf(uint64_t x, uint64_t last) {
+        if (x == last) return 0;
+#if defined(_MSC_VER)
+        unsigned long i;
+        _BitScanReverse64(&i, x ^ last);
+        return (int)i + 1;
+#else
+        return 64 - __builtin_clzll(x ^ last);
+#endif
+    }
+
+public:
+    explicit RadixHeap(int) : last(0), count(0) {}
+    bool empty() const { return count == 0; }
+
+    void push(int v, long long key) {
+        buckets[bucketOf((uint64_t)key, last)].push_back({(uint64_t)key, v});
+        count++;
+    }
+
+    pair<int, long long> pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) ++i;
+            uint64_t mn = buckets[i][0].first;
+            for (const auto& e : buckets[i]) mn = min(mn, e.first);
+            last = mn;
+            for (const auto& e : buckets[i]) buckets[bucketOf(e.first, last)].push_back(e);
+            buckets[i].clear();
+        }
+        pair<uint64_t, int> e = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return {e.second, (long long)e.first};
+    }
+};
+
+struct ShortestPaths {
+    vector<long long> dist;   // LLONG_MAX ʾɴ
+    vector<int> pred;         // ·ϵǰԴ벻ɴﶥΪ -1
+
+    // Դ㵽 t ĶУɴʱΪ
+    vector<int> path(int t) const {
+        vector<int> p;
+        if (dist[t] == LLONG_MAX) return p;
+        for (int v = t; v != -1; v = pred[v]) p.push_back(v);
+        reverse(p.begin(), p.end());
+        return p;
+    }
+};
+
+template <typename Queue>
+void runDijkstra(const CSR& g, const vector<int>& sources, int target, ShortestPaths& sp) {
+    Queue q(g.n);
+    for (int s : sources) {
+        if (sp.dist[s] == 0) continue;
+        sp.dist[s] = 0;
+        q.push(s, 0);
+    }
+    while (!q.empty()) {
+        pair<int, long long> top = q.pop();
+        int u = top.first;
+        long long d = top.second;
+        if (d > sp.dist[u]) continue;   // Ŀ
+        if (u == target) break;         // Ŀȷǰ
+        for (int64_t i = g.offset[u]; i < g.offset[u + 1]; ++i) {
+            int v = g.target[i];
+            long long nd = d + g.weight[i];
+            if (nd < sp.dist[v]) {
+                sp.dist[v] = nd;
+                sp.pred[v] = u;
+                q.push(v, nd);
+            }
+        }
+    }
+}
+
+// Դ DijkstraԴΪ 0target >= 0 ʱӺأ
+// ʱֻ targetѳӶ㣩ľֵ
+ShortestPaths dijkstraCSR(const CSR& g, const vector<int>& sources,
+                          PQKind kind = PQKind::QuaryHeap, int target = -1) {
+    ShortestPaths sp;
+    sp.dist.assign(g.n, LLONG_MAX);
+    sp.pred.assign(g.n, -1);
+    switch (kind) {
+    case PQKind::BinaryHeap: runDijkstra<BinaryHeapQueue>(g, sources, target, sp); break;
+    case PQKind::QuaryHeap:  runDijkstra<QuaryHeap>(g, sources, target, sp); break;
+    case PQKind::RadixHeap:  runDijkstra<RadixHeap>(g, sources, target, sp); break;
+    }
+    return sp;
+}
+
+// ========================
+//  BFSŻԶ / ԵԶл
+// ========================
+struct BFSResult {
+    vector<int> level;    // ţ-1 ʾɴ
+    vector<int> parent;   // BFS ڵ㣻ԴĸڵΪɴΪ -1
+    int topDownSteps;
+    int bottomUpSteps;
+};
+
+static inline int ctz64(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return (int)i;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+//  threads ̣߳ߣ f(̺߳)
+template <typename F>
+void runThreads(int threads, F f) {
+    vector<thread> pool;
+    for (int t = 1; t < threads; ++t) pool.emplace_back(f, t);
+    f(0);
+    for (auto& th : pool) th.join();
+}
+
+//  [0, count)  chunk п飬 threads ̶̬߳ȡf(lo, hi) һ
+template <typename F>
+void parallelFor(int threads, size_t count, size_t chunk, F f) {
+    atomic<size_t> cursor(0);
+    runThreads(threads, [&](int) {
+        for (size_t lo; (lo = cursor.fetch_add(chunk)) < count;) f(lo, min(lo + chunk, count));
+    });
+}
+
+// Beamer ʽŻǰس mf δʶ mu / ALPHA ʱΪԵϣ
+// ǰض n / BETA ʱлԶ
+BFSResult bfsCSR(const CSR& g, const vector<int>& sources, int threads = 0) {
+    const int64_t ALPHA = 14, BETA = 24;
+    const size_t CHUNK = 256;     // Զÿȡǰض
+    const size_t WORD_CHUNK = 64; // Եÿȡλͼ
+    int n = g.n;
+    if (threads <= 0) threads = (int)max(1u, thread::hardware_concurrency());
+
+    BFSResult r;
+    r.level.assign(n, -1);
+    r.parent.assign(n, -1);
+    r.topDownSteps = r.bottomUpSteps = 0;
+
+    size_t words = ((size_t)n + 63) / 64;
+    vector<atomic<uint64_t>> visited(words);
+    for (auto& w : visited) w.store(0, memory_order_relaxed);
+    vector<uint64_t> front(words, 0), next(words, 0);   // Եʱǰλͼ
+    vector<int> frontier;                               // Զʱǰб
+    vector<vector<int>> local(threads);                 // ̵߳һ㻺
+    vector<int64_t> edgeSum(threads), found(threads);
+
+    int64_t mf = 0;
+    for (int s : sources) {
+        if (visited[s >> 6].fetch_or(1ULL << (s & 63)) & (1ULL << (s & 63))) continue;
+        r.level[s] = 0;
+        r.parent[s] = s;
+        frontier.push_back(s);
+        mf += g.degree(s);
+    }
+    int64_t mu = g.edgeCount() - mf, nf = (int64_t)frontier.size();
+    bool bottomUp = false;
+
+    for (int depth = 0; nf > 0; ++depth) {
+        if (!bottomUp && mf > mu / ALPHA) {
+            fill(front.begin(), front.end(), 0);
+            for (int v : frontier) front[v >> 6] |= 1ULL << (v & 63);
+            bottomUp = true;
+        } else if (bottomUp && nf < n / BETA) {
+            frontier.clear();
+            for (size_t w = 0; w < words; ++w)
+                for (uint64_t x = front[w]; x; x &= x - 1) frontier.push_back((int)(64 * w + ctz64(x)));
+            bottomUp = false;
+        }
+
+        atomic<size_t> cursor(0);
+        if (!bottomUp) {
+            r.topDownSteps++;
+            runThreads(threads, [&](int t) {
+                vector<int>& out = local[t];
+                out.clear();
+                int64_t m = 0;
+                for (size_t lo; (lo = cursor.fetch_add(CHUNK)) < frontier.size();) {
+                    size_t hi = min(lo + CHUNK, frontier.size());
+                    for (size_t k = lo; k < hi; ++k) {
+                        int u = frontier[k];
+                        for (int64_t i = g.offset[u]; i < g.offset[u + 1]; ++i) {
+                            int v = g.target[i];
+                            uint64_t bit = 1ULL << (v & 63);
+                            if (visited[v >> 6].load(memory_order_relaxed) & bit) continue;
+                            if (visited[v >> 6].fetch_or(bit) & bit) continue;   // ߳
+                            r.parent[v] = u;
+                            r.level[v] = depth + 1;
+                            out.push_back(v);
+                            m += g.degree(v);
+                        }
+                    }
+                }
+                edgeSum[t] = m;
+            });
+            frontier.clear();
+            for (auto& out : local) frontier.insert(frontier.end(), out.begin(), out.end());
+            nf = (int64_t)frontier.size();
+        } else {
+            r.bottomUpSteps++;
+            runThreads(threads, [&](int t) {
+                int64_t m = 0, cnt = 0;
+                for (size_t lo; (lo = cursor.fetch_add(WORD_CHUNK)) < words;) {
+                    size_t hi = min(lo + WORD_CHUNK, words);
+                    for (size_t w = lo; w < hi; ++w) {
+                        uint64_t todo = ~visited[w].load(memory_order_relaxed), add = 0;
+                        if (w == words - 1 && (n & 63)) todo &= (1ULL << (n & 63)) - 1;
+                        for (; todo; todo &= todo - 1) {
+                            int b = ctz64(todo);
+                            int v = (int)(64 * w + b);
+                            for (int64_t i = g.offset[v]; i < g.offset[v + 1]; ++i) {
+                                int u = g.target[i];
+                                if ((front[u >> 6] >> (u & 63)) & 1) {   // ҵһǰھӼֹͣ
+                                    r.parent[v] = u;
+                                    r.level[v] = depth + 1;
+                                    add |= 1ULL << b;
+                                    m += g.degree(v);
+                                    cnt++;
+                                    break;
+                                }
+                            }
+                        }
+                        next[w] = add;
+                        if (add) visited[w].fetch_or(add, memory_order_relaxed);
+                    }
+                }
+                edgeSum[t] = m;
+                found[t] = cnt;
+            });
+            swap(front, next);
+            nf = 0;
+            for (int t = 0; t < threads; ++t) nf += found[t];
+        }
+        mf = 0;
+        for (int t = 0; t < threads; ++t) mf += edgeSum[t];
+        mu -= mf;
+    }
+    return r;
+}
+
+BFSResult bfsCSR(const CSR& g, int source, int threads = 0) {
+    return bfsCSR(g, vector<int>(1, source), threads);
+}
+
+// 鼯ֻѽϴĸҵСĸ£find  CAS ·
+class ConcurrentDSU {
+private:
+    vector<atomic<int>> p;
+
+public:
+    explicit ConcurrentDSU(int n) : p(n) {
+        for (int i = 0; i < n; ++i) p[i].store(i, memory_order_relaxed);
+    }
+
+    int find(int x) {
+        while (true) {
+            int q = p[x].load(memory_order_relaxed);
+            if (q == x) return x;
+            int r = p[q].load(memory_order_relaxed);
+            if (r != q) p[x].compare_exchange_weak(q, r, memory_order_relaxed);
+            x = r;
+        }
+    }
+
+    void unite(int a, int b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return;
+            if (a < b) swap(a, b);
+            int expect = a;
+            if (p[a].compare_exchange_strong(expect, b)) return;
+        }
+    }
+};
+
+// ========================
+// Сɭ֣Kruskal /  Boruvka
+// ========================
+struct SpanningForest {
+    vector<Edge> edges;   // ɭеı
+    long long total;      // Ȩ
+    int components;       // ͨ
+};
+
+// 鼯·ѹ + Ⱥϲ
+class DisjointSet {
+private:
+    vector<int> parent;
+    vector<unsigned char> rank;
+
+public:
+    explicit DisjointSet(int n) : parent(n), rank(n, 0) {
+        for (int i = 0; i < n; ++i) parent[i] = i;
+    }
+
+    int find(int x) {
+        int r = x;
+        while (parent[r] != r) r = parent[r];
+        while (parent[x] != r) {
+            int next = parent[x];
+            parent[x] = r;
+            x = next;
+        }
+        return r;
+    }
+
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (rank[a] < rank[b]) swap(a, b);
+        parent[b] = a;
+        if (rank[a] == rank[b]) rank[a]++;
+        return true;
+    }
+};
+
+// ÿֻȡ u < v һԻ
+static vector<Edge> undirectedEdges(const CSR& g) {
+    vector<Edge> edges;
+    edges.reserve(g.edgeCount() / 2);
+    for (int u = 0; u < g.n; ++u)
+        for (int64_t i = g.offset[u]; i < g.offset[u + 1]; ++i)
+            if (u < g.target[i]) edges.push_back({u, g.target[i], g.weight[i]});
+    return edges;
+}
+
+SpanningForest kruskalCSR(const CSR& g) {
+    vector<Edge> edges = undirectedEdges(g);   //  (u, v) 򣻱С 2^32
+    //  32 λȨء 32 λߺţͬȨ߰ (u, v)  Boruvka ƽֹһ
+    vector<uint64_t> order(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i) order[i] = ((uint64_t)(uint32_t)edges[i].w << 32) | i;
+    sort(order.begin(), order.end());
+
+    SpanningForest f{{}, 0, g.n};
+    DisjointSet ds(g.n);
+    for (uint64_t key : order) {
+        if ((int)f.edges.size() == g.n - 1) break;
+        const Edge& e = edges[(uint32_t)key];
+        if (!ds.unite(e.u, e.v)) continue;
+        f.edges.push_back(e);
+        f.total += e.w;
+    }
+    f.components = g.n - (int)f.edges.size();
+    return f;
+}
+
+// ÿֲеΪÿĳߣȨͬʱȽϱߺţ֤޻
+// ϲر޳ͬһıߣÿټ
+SpanningForest boruvkaCSR(const CSR& g, int threads = 0) {
+    const size_t CHUNK = 4096;
+    if (threads <= 0) threads = (int)max(1u, thread::hardware_concurrency());
+    int n = g.n;
+    vector<Edge> edges = undirectedEdges(g);   //  (u, v) ±꼴ƽֹ򣻱С 2^32
+    vector<int> comp(n), active(n), rep(n);
+    for (int v = 0; v < n; ++v) comp[v] = active[v] = v;
+    vector<uint32_t> alive(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i) alive[i] = (uint32_t)i;
+    vector<atomic<uint64_t>> best(n);
+    vector<vector<uint32_t>> local(threads);
+
+    SpanningForest f{{}, 0, n};
+    DisjointSet ds(n);
+    while (!alive.empty()) {
+        parallelFor(threads, active.size(), CHUNK, [&](size_t lo, size_t hi) {
+            for (size_t k = lo; k < hi; ++k) best[active[k]].store(UINT64_MAX, memory_order_relaxed);
+        });
+
+        // 1. ߣ 32 λΪȨأ 32 λΪߺţȡСֵ
+        parallelFor(threads, alive.size(), CHUNK, [&](size_t lo, size_t hi) {
+            for (size_t k = lo; k < hi; ++k) {
+                const Edge& e = edges[alive[k]];
+                uint64_t key = ((uint64_t)(uint32_t)e.w << 32) | alive[k];
+                for (int c : {comp[e.u], comp[e.v]}) {
+                    uint64_t cur = best[c].load(memory_order_relaxed);
+                    while (key < cur && !best[c].compare_exchange_weak(cur, key, memory_order_relaxed)) {}
+                }
+            }
+        });
+
+        // 2. ϲѡͬһߵֻһ
+        for (int c : active) {
+            uint64_t key = best[c].load(memory_order_relaxed);
+            if (key == UINT64_MAX) continue;
+            const Edge& e = edges[(uint32_t)key];
+            if (!ds.unite(comp[e.u], comp[e.v])) continue;
+            f.edges.push_back(e);
+            f.total += e.w;
+        }
+
+        // 3. ر޳ڲ
+        size_t kept = 0;
+        for (int c : active) {
+            rep[c] = ds.find(c);
+            if (rep[c] == c) active[kept++] = c;
+        }
+        active.resize(kept);
+        parallelFor(threads, (size_t)n, CHUNK, [&](size_t lo, size_t hi) {
+            for (size_t v = lo; v < hi; ++v) comp[v] = rep[comp[v]];
+        });
+        atomic<size_t> cursor(0);
+        runThreads(threads, [&](int t) {
+            vector<uint32_t>& out = local[t];
+            for (size_t lo; (lo = cursor.fetch_add(CHUNK)) < alive.size();) {
+                for (size_t k = lo; k < min(lo + CHUNK, alive.size()); ++k) {
+                    const Edge& e = edges[alive[k]];
+                    if (comp[e.u] != comp[e.v]) out.push_back(alive[k]);
+                }
+            }
+        });
+        alive.clear();
+        for (auto& out : local) {
+            alive.insert(alive.end(), out.begin(), out.end());
+            out.clear();
+        }
+    }
+    f.components = n - (int)f.edges.size();
+    return f;
+}
+
+// ========================
+// ı߱ȡн
+// ========================
+// ֳ֧ʽ
+//   SNAPÿ "u v [w]" 0 ţ'#'  '%' ͷΪע
+//   DIMACS"c" עͣ"p sp n m" "a u v w" "e u v"Ϊߣ 1 
+// ȱʡȨΪ 1ļ߳п飬ÿӿڵһ׽ԽβһС
+struct EdgeListPart {
+    vector<Edge> edges;
+    int64_t maxId;      // ֹ󶥵
+    int64_t declared;   // "p" Ķ
+    bool bad;
+};
+
+static const char* skipBlank(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    return p;
+}
+
+// ѡŵֵ INT_MAX
+static bool parseInt(const char*& p, const char* end, int64_t& x) {
+    p = skipBlank(p, end);
+    bool neg = p < end && *p == '-';
+    if (neg) ++p;
+    if (p == end || *p < '0' || *p > '9') return false;
+    x = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+        x = x * 10 + (*p - '0');
+        if (x > INT_MAX) return false;
+    }
+    if (neg) x = -x;
+    return true;
+}
+
+static void parseEdgeLine(const char* p, const char* end, EdgeListPart& part) {
+    p = skipBlank(p, end);
+    if (p == end || *p == '#' || *p == '%' || *p == 'c') return;
+    int64_t u, v, w = 1, first = 0;
+    if (*p == 'p') {
+        p = skipBlank(p + 1, end);
+        while (p < end && *p != ' ' && *p != '\t') ++p;   // ͣ sp / edge
+        if (parseInt(p, end, u) && u >= 0) part.declared = max(part.declared, u);
+        else part.bad = true;
+        return;
+    }
+    if (*p == 'a' || *p == 'e') {
+        first = 1;
+        ++p;
+    }
+    if (!parseInt(p, end, u) || !parseInt(p, end, v)) {
+        part.bad = true;
+        return;
+    }
+    p = skipBlank(p, end);
+    if (p < end && !parseInt(p, end, w)) {
+        part.bad = true;
+        return;
+    }
+    u -= first;
+    v -= first;
+    if (u < 0 || v < 0 || u >= INT_MAX || v >= INT_MAX) {
+        part.bad = true;
+        return;
+    }
+    part.maxId = max(part.maxId, max(u, v));
+    part.edges.push_back({(int)u, (int)v, (int)w});
+}
+
+// ߱κһиʽ󶼷 false
+bool readEdgeList(const char* path, int& n, vector<Edge>& edges, int threads = 0) {
+    MappedFile f;
+    if (!f.open(path)) return false;
+    if (threads <= 0) threads = (int)max(1u, thread::hardware_concurrency());
+    const char* base = (const char*)f.data();
+    size_t len = f.size();
+
+    vector<EdgeListPart> parts(threads);
+    runThreads(threads, [&](int t) {
+        EdgeListPart& part = parts[t];
+        part.maxId = part.declared = -1;
+        part.bad = false;
+        size_t lo = len * t / threads, hi = len * (t + 1) / threads;
+        while (lo > 0 && lo < hi && base[lo - 1] != '\n') ++lo;
+        const char* end = base + len;
+        for (const char* p = base + lo; p < base + hi;) {
+            const char* e = (const char*)memchr(p, '\n', end - p);
+            if (!e) e = end;
+            parseEdgeLine(p, e, part);
+            p = e + 1;
+        }
+    });
+
+    int64_t count = -1, total = 0;
+    for (const EdgeListPart& part : parts) {
+        if (part.bad) return false;
+        count = max(count, max(part.maxId + 1, part.declared));
+        total += (int64_t)part.edges.size();
+    }
+    if (count > INT_MAX) return false;
+    n = (int)max<int64_t>(count, 0);
+    edges.clear();
+    edges.reserve(total);
+    for (EdgeListPart& part : parts) {
+        edges.insert(edges.end(), part.edges.begin(), part.edges.end());
+        vector<Edge>().swap(part.edges);
+    }
+    return true;
+}
+
+// ========================
+// ͨͼࣨCSR 洢O(V+E) ռ䣩
 // ========================
 class Graph {
 public:
     int n; // 
-    vector<vector<int>> adjMatrix;
-    vector<string> labels; // ǩ "A", "B" ...
+    CSR csr;
+    vector<Edge> pending;  // δ CSR ı
+    vector<string> labels; // ǩ "A", "B" ...Ϊʱ
+
+    Graph(int size, const vector<string>& lbls = vector<string>()) : n(size), labels(lbls) {
+        csr.build(n, pending, true);
+    }
 
-    Graph(int size, const vector<string>& lbls) : n(size), labels(lbls) {
-        adjMatrix.assign(n, vector<int>(n, 0));
+    // ֱɱ߱ͼƼ addEdge
+    Graph(int size, const vector<Edge>& edges, const vector<string>& lbls = vector<string>())
+        : n(size), labels(lbls) {
+        csr.build(n, edges, true);
     }
 
+    // ֱʹ CSR CSR::load ӳĿգֻѯӱʱתΪд洢
+    Graph(CSR g, const vector<string>& lbls = vector<string>()) : n(g.n), csr(move(g)), labels(lbls) {}
+
     void addEdge(int u, int v, int weight = 1) {
-        adjMatrix[u][v] = weight;
-        adjMatrix[v][u] = weight; // ͼ
+        pending.push_back({u, v, weight}); // ͼʱ˫չ
+    }
+
+    // Ѵı߲ CSR㷨ʼǰԶ
+    void finalize() {
+        if (pending.empty()) return;
+        vector<Edge> all;
+        all.reserve(csr.edgeCount() / 2 + pending.size());
+        csr.appendEdges(all);
+        all.insert(all.end(), pending.begin(), pending.end());
+        pending.clear();
+        csr.build(n, all, true);
+    }
+
+    string label(int u) const {
+        return u < (int)labels.size() ? labels[u] : to_string(u);
     }
 
     void printAdjMatrix() {
+        finalize();
         cout << "ڽӾ:\n";
         cout << "   ";
-        for (const string& l : labels) cout << l << " ";
+        for (int i = 0; i < n; ++i) cout << label(i) << " ";
         cout << "\n";
         for (int i = 0; i < n; ++i) {
-            cout << labels[i] << "  ";
+            cout << label(i) << "  ";
             for (int j = 0; j < n; ++j) {
-                if (adjMatrix[i][j] == 0 && i != j)
+                int w = csr.weightOf(i, j);
+                if (w == 0 && i != j)
                     cout << ". ";
                 else
-                    cout << adjMatrix[i][j] << " ";
+                    cout << w << " ";
             }
             cout << "\n";
         }
     }
 
-    // BFS  start ʼ
-    void BFS(int start) {
+    // BFS 
+    vector<int> bfsOrder(int start) {
+        finalize();
+        vector<int> order;
         vector<bool> visited(n, false);
         queue<int> q;
         q.push(start);
         visited[start] = true;
-        cout << "BFS (" << labels[start] << "): ";
         while (!q.empty()) {
             int u = q.front(); q.pop();
-            cout << labels[u] << " ";
-            for (int v = 0; v < n; ++v) {
-                if (adjMatrix[u][v] > 0 && !visited[v]) {
+            order.push_back(u);
+            for (int64_t i = csr.offset[u]; i < csr.offset[u + 1]; ++i) {
+                int v = csr.target[i];
+                if (!visited[v]) {
                     visited[v] = true;
                     q.push(v);
                 }
             }
         }
+        return order;
+    }
+
+    // BFS  start ʼ
+    void BFS(int start) {
+        cout << "BFS (" << label(start) << "): ";
+        for (int u : bfsOrder(start)) cout << label(u) << " ";
         cout << "\n";
     }
 
-    // DFS  start ʼݹ飩
-    void DFSUtil(int u, vector<bool>& visited) {
-        visited[u] = true;
-        cout << labels[u] << " ";
-        for (int v = 0; v < n; ++v) {
-            if (adjMatrix[u][v] > 0 && !visited[v]) {
-                DFSUtil(v, visited);
+    // зŻ BFSز븸ڵ
+    BFSResult parallelBFS(int source, int threads = 0) {
+        finalize();
+        return bfsCSR(csr, source, threads);
+    }
+
+    // DFS  start ʼʽջÿ¼һڱߣ˳ݹͬ
+    void DFSUtil(int start, vector<bool>& visited, vector<int>& order) {
+        vector<pair<int, int64_t>> path;
+        visited[start] = true;
+        order.push_back(start);
+        path.push_back({start, csr.offset[start]});
+        while (!path.empty()) {
+            int u = path.back().first;
+            int64_t i = path.back().second;
+            if (i == csr.offset[u + 1]) {
+                path.pop_back();
+                continue;
+            }
+            path.back().second++;
+            int v = csr.target[i];
+            if (!visited[v]) {
+                visited[v] = true;
+                order.push_back(v);
+                path.push_back({v, csr.offset[v]});
             }
         }
     }
 
-    void DFS(int start) {
+    vector<int> dfsOrder(int start) {
+        finalize();
         vector<bool> visited(n, false);
-        cout << "DFS (" << labels[start] << "): ";
-        DFSUtil(start, visited);
+        vector<int> order;
+        DFSUtil(start, visited, order);
+        return order;
+    }
+
+    void DFS(int start) {
+        cout << "DFS (" << label(start) << "): ";
+        for (int u : dfsOrder(start)) cout << label(u) << " ";
         cout << "\n";
     }
 
+    // ·ؾǰ飬ֶ֧ԴĿǰͲͬȶ
+    ShortestPaths shortestPaths(const vector<int>& sources, PQKind kind = PQKind::QuaryHeap, int target = -1) {
+        finalize();
+        return dijkstraCSR(csr, sources, kind, target);
+    }
+
     // Dijkstra · start 
     void dijkstra(int start) {
-        vector<int> dist(n, INT_MAX);
-        vector<bool> visited(n, false);
-        dist[start] = 0;
-
-        for (int count = 0; count < n; ++count) {
-            int u = -1;
-            for (int i = 0; i < n; ++i) {
-                if (!visited[i] && (u == -1 || dist[i] < dist[u]))
-                    u = i;
-            }
-
-            visited[u] = true;
-            for (int v = 0; v < n; ++v) {
-                if (adjMatrix[u][v] > 0 && !visited[v]) {
-                    if (dist[u] + adjMatrix[u][v] < dist[v]) {
-                        dist[v] = dist[u] + adjMatrix[u][v];
-                    }
-                }
-            }
-        }
-
-        cout << "Dijkstra from " << labels[start] << ":\n";
+        vector<long long> dist = shortestPaths({start}).dist;
+        cout << "Dijkstra from " << label(start) << ":\n";
         for (int i = 0; i < n; ++i) {
-            cout << labels[start] << "->" << labels[i] << ": ";
-            if (dist[i] == INT_MAX) cout << "INF\n";
+            cout << label(start) << "->" << label(i) << ": ";
+            if (dist[i] == LLONG_MAX) cout << "INF\n";
             else cout << dist[i] << "\n";
         }
     }
 
-    // Prim С
-    void primMST() {
+    // Prim Сѣ (parent, child, weight) ˳
+    vector<Edge> primEdges() {
+        finalize();
         vector<int> key(n, INT_MAX);
         vector<bool> inMST(n, false);
         vector<int> parent(n, -1);
+        vector<Edge> tree;
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
 
         key[0] = 0;
+        for (int root = 0; root < n; ++root) {
+            // ѿʱԭɨһ£ӱСδ붥
+            if (inMST[root]) continue;
+            pq.push({key[root], root});
+            while (!pq.empty()) {
+                int u = pq.top().second; pq.pop();
+                if (inMST[u]) continue;
+                inMST[u] = true;
+                if (parent[u] != -1) tree.push_back({parent[u], u, key[u]});
 
-        for (int count = 0; count < n; ++count) {
-            int u = -1;
-            for (int i = 0; i < n; ++i) {
-                if (!inMST[i] && (u == -1 || key[i] < key[u]))
-                    u = i;
+                for (int64_t i = csr.offset[u]; i < csr.offset[u + 1]; ++i) {
+                    int v = csr.target[i];
+                    if (!inMST[v] && csr.weight[i] < key[v]) {
+                        parent[v] = u;
+                        key[v] = csr.weight[i];
+                        pq.push({key[v], v});
+                    }
+                }
             }
+        }
+        return tree;
+    }
 
-            inMST[u] = true;
-            if (parent[u] != -1) {
-                cout << labels[parent[u]] << " - " << labels[u]
-                     << " : " << adjMatrix[u][parent[u]] << "\n";
-            }
+    // Сɭ֣ر߼Ȩأͼͨʱÿһ
+    SpanningForest kruskalMST() {
+        finalize();
+        return kruskalCSR(csr);
+    }
 
-            for (int v = 0; v < n; ++v) {
-                if (adjMatrix[u][v] > 0 && !inMST[v] && adjMatrix[u][v] < key[v]) {
-                    parent[v] = u;
-                    key[v] = adjMatrix[u][v];
-                }
-            }
+    SpanningForest boruvkaMST(int threads = 0) {
+        finalize();
+        return boruvkaCSR(csr, threads);
+    }
+
+    // Prim С
+    void primMST() {
+        for (const Edge& e : primEdges()) {
+            cout << label(e.u) << " - " << label(e.v) << " : " << e.w << "\n";
         }
     }
 };
 
 // ========================
-// Tarjan ˫ͨ & ؽڵ㣨ͼ2
+// Tarjan ˫ͨ & ؽڵ㣨ͼ2ʽջ
 // ========================
 class Biconnected {
 public:
-    vector<vector<int>> adj;
+    int n;
+    CSR adj;
+    vector<Edge> edges;
     vector<int> disc, low, parent;
-    vector<bool> visited;
     int time;
-    set<int> articulationPoints;
-    vector<vector<pair<int,int>>> bcc; // ÿ BCC ı
-    stack<pair<int,int>> stk;
+    vector<uint64_t> articulation;     // ؽڵλͼ
+    vector<int> edgeComp;              // edges[i] ţԻΪ -1 CSR ʱ CSR λ
+    vector<pair<int,int>> compEdges;   // ı߰ջ˳ţ findBCC д
+    vector<int> compStart;             //  c ıΪ compEdges[compStart[c] .. compStart[c+1])
+    vector<pair<int,int>> bridges;     //  (, )
+    int numComps;
+
+    Biconnected(int size) : n(size), time(0), numComps(0), fromCSR(false) {}
+
+    // ֱ CSRΪӳĿգϼ㣬 addEdge
+    Biconnected(const CSR& g) : n(g.n), adj(g), time(0), numComps(0), fromCSR(true) {}
 
-    Biconnected(int n) {
-        adj.resize(n);
+    void addEdge(int u, int v) {
+        edges.push_back({u, v, 1});
+    }
+
+    bool isArticulation(int v) const { return (articulation[v >> 6] >> (v & 63)) & 1; }
+
+private:
+    bool fromCSR;
+    vector<int> children;
+    vector<int64_t> cursor;            // cursor[u]u һڱ
+    vector<int> slotComp;              // CSR λÿֻһѹջ
+    vector<pair<int,int64_t>> stk;     // ջ(, CSR λ)
+    vector<int> path;                  // ģݹջ
+
+    void reset(bool components) {
         disc.assign(n, -1);
         low.assign(n, -1);
         parent.assign(n, -1);
-        visited.assign(n, false);
+        children.assign(n, 0);
+        cursor.assign(n, 0);
+        articulation.assign(((size_t)n + 63) / 64, 0);
+        slotComp.assign(components ? adj.edgeCount() : 0, -1);
+        edgeComp.clear();
+        compEdges.clear();
+        compStart.assign(1, 0);
+        bridges.clear();
+        stk.clear();
+        numComps = 0;
         time = 0;
     }
 
-    void addEdge(int u, int v) {
-        adj[u].push_back(v);
-        adj[v].push_back(u);
-    }
+    void markArticulation(int v) { articulation[v >> 6] |= 1ULL << (v & 63); }
 
-    void dfs(int u) {
-        int children = 0;
-        visited[u] = true;
-        disc[u] = low[u] = ++time;
+    // ݹ˳ͬѹ path """"¸ڵ
+    void dfs(int root, bool components) {
+        disc[root] = low[root] = ++time;
+        cursor[root] = adj.offset[root];
+        path.push_back(root);
+        while (!path.empty()) {
+            int u = path.back();
+            if (cursor[u] < adj.offset[u + 1]) {
+                int64_t s = cursor[u]++;
+                int v = adj.target[s];
+                if (disc[v] < 0) {
+                    children[u]++;
+                    parent[v] = u;
+                    if (components) stk.push_back({u, s});
+                    disc[v] = low[v] = ++time;
+                    cursor[v] = adj.offset[v];
+                    path.push_back(v);
+                } else if (v != parent[u] && disc[v] < disc[u]) {
+                    low[u] = min(low[u], disc[v]);
+                    if (components) stk.push_back({u, s});
+                }
+                continue;
+            }
 
-        for (int v : adj[u]) {
-            if (!visited[v]) {
-                children++;
-                parent[v] = u;
-                stk.push({u, v});
-                dfs(v);
-                low[u] = min(low[u], low[v]);
-
-                // ڵж  ؽڵ
-                if (parent[u] == -1 && children > 1)
-                    articulationPoints.insert(u);
-                // Ǹڵ low[v] >= disc[u]
-                if (parent[u] != -1 && low[v] >= disc[u])
-                    articulationPoints.insert(u);
-
-                if (low[v] >= disc[u]) {
-                    vector<pair<int,int>> comp;
-                    while (true) {
-                        auto edge = stk.top(); stk.pop();
-                        comp.push_back(edge);
-                        if (edge.first == u && edge.second == v) break;
-                    }
-                    bcc.push_back(comp);
+            path.pop_back();
+            int p = parent[u];
+            if (p < 0) continue;
+            low[p] = min(low[p], low[u]);
+
+            // ڵж  ؽڵ
+            if (parent[p] == -1 && children[p] > 1) markArticulation(p);
+            // Ǹڵ low[v] >= disc[u]
+            if (parent[p] != -1 && low[u] >= disc[p]) markArticulation(p);
+            if (low[u] > disc[p]) bridges.push_back({p, u});
+
+            if (components && low[u] >= disc[p]) {
+                while (true) {
+                    pair<int,int64_t> e = stk.back();
+                    stk.pop_back();
+                    int v = adj.target[e.second];
+                    compEdges.push_back({e.first, v});
+                    slotComp[e.second] = numComps;
+                    if (e.first == p && v == u) break;
                 }
-            } else if (v != parent[u] && disc[v] < disc[u]) {
-                low[u] = min(low[u], disc[v]);
-                stk.push({u, v});
+                compStart.push_back((int)compEdges.size());
+                numComps++;
             }
         }
     }
 
-    void findBCC(int start = 0) {
-        dfs(start);
+    void run(int start, bool components) {
+        if (!fromCSR) adj.build(n, edges, true);
+        reset(components);
+        if (n == 0) return;
+        dfs(start, components);
         // ʣߣͼͨ
-        for (int i = 0; i < adj.size(); ++i) {
-            if (!visited[i]) dfs(i);
+        for (int i = 0; i < n; ++i) {
+            if (disc[i] < 0) dfs(i, components);
         }
     }
 
+public:
+    void findBCC(int start = 0) {
+        run(start, true);
+        if (fromCSR) {
+            edgeComp.assign(adj.edgeCount(), -1);
+            for (int u = 0; u < n; ++u)
+                for (int64_t i = adj.offset[u]; i < adj.offset[u + 1]; ++i)
+                    if (adj.target[i] != u) edgeComp[i] = max(slotComp[i], slotComp[adj.slotOf(adj.target[i], u)]);
+            return;
+        }
+        edgeComp.assign(edges.size(), -1);
+        for (size_t i = 0; i < edges.size(); ++i) {
+            int u = edges[i].u, v = edges[i].v;
+            if (u != v) edgeComp[i] = max(slotComp[adj.slotOf(u, v)], slotComp[adj.slotOf(v, u)]);
+        }
+    }
+
+    // ֻؽڵ㣬άջ
+    const vector<pair<int,int>>& findBridges(int start = 0) {
+        run(start, false);
+        return bridges;
+    }
+
+    // TarjanCVishkinɭ +  + ͼͨԣ㲢С
+    // ɭȡԴ BFS С BFS ԵϡԶ¸ɨһ
+    // ŷ·ϵд articulationedgeCompbridgesnumComps compEdges
+    void parallelBCC(int threads = 0) {
+        const size_t CHUNK = 4096;   // 64 ı֤ÿλͼֻһ߳д
+        if (!fromCSR) adj.build(n, edges, true);
+        if (threads <= 0) threads = (int)max(1u, thread::hardware_concurrency());
+        reset(false);
+
+        // 1. ÿͨȡСĶΪԴ BFS õɭ
+        ConcurrentDSU cc(n);
+        parallelFor(threads, n, CHUNK, [&](size_t lo, size_t hi) {
+            for (size_t u = lo; u < hi; ++u)
+                for (int64_t i = adj.offset[u]; i < adj.offset[u + 1]; ++i)
+                    if ((int)u < adj.target[i]) cc.unite((int)u, adj.target[i]);
+        });
+        vector<int> roots;
+        for (int v = 0; v < n; ++v) if (cc.find(v) == v) roots.push_back(v);
+        BFSResult tree = bfsCSR(adj, roots, threads);
+        const vector<int>& par = tree.parent;
+
+        // 2. Ͱӽڵ
+        int depth = 0;
+        for (int v = 0; v < n; ++v) depth = max(depth, tree.level[v] + 1);
+        vector<int> byLevel(n), levStart(depth + 1, 0), kids(n), kidStart(n + 1, 0);
+        for (int v = 0; v < n; ++v) {
+            levStart[tree.level[v] + 1]++;
+            if (par[v] != v) kidStart[par[v] + 1]++;
+        }
+        for (int d = 0; d < depth; ++d) levStart[d + 1] += levStart[d];
+        for (int v = 0; v < n; ++v) kidStart[v + 1] += kidStart[v];
+        {
+            vector<int> lp(levStart.begin(), levStart.end() - 1), kp(kidStart.begin(), kidStart.end() - 1);
+            for (int v = 0; v < n; ++v) {
+                byLevel[lp[tree.level[v]]++] = v;
+                if (par[v] != v) kids[kp[par[v]]++] = v;
+            }
+        }
+        auto eachLevel = [&](int d, auto body) {
+            parallelFor(threads, levStart[d + 1] - levStart[d], CHUNK, [&](size_t lo, size_t hi) {
+                for (size_t k = lo; k < hi; ++k) body(byLevel[levStart[d] + k]);
+            });
+        };
+
+        // 3. СԵϣԶ
+        vector<int> sz(n, 1), pre(n, 0);
+        for (int d = depth - 1; d >= 0; --d)
+            eachLevel(d, [&](int u) {
+                for (int k = kidStart[u]; k < kidStart[u + 1]; ++k) sz[u] += sz[kids[k]];
+            });
+        for (int r = 0, next = 0; r < (int)roots.size(); ++r) {
+            pre[roots[r]] = next;
+            next += sz[roots[r]];
+        }
+        for (int d = 0; d < depth; ++d)
+            eachLevel(d, [&](int u) {
+                int next = pre[u] + 1;
+                for (int k = kidStart[u]; k < kidStart[u + 1]; ++k) {
+                    pre[kids[k]] = next;
+                    next += sz[kids[k]];
+                }
+            });
+
+        // 4. lowPre / highPreڵķܵС / 
+        vector<int> lowPre(n), highPre(n);
+        auto isTree = [&](int a, int b) { return par[b] == a || par[a] == b; };
+        for (int d = depth - 1; d >= 0; --d)
+            eachLevel(d, [&](int u) {
+                int lo = pre[u], hi = pre[u];
+                for (int64_t i = adj.offset[u]; i < adj.offset[u + 1]; ++i) {
+                    int v = adj.target[i];
+                    if (isTree(u, v)) continue;
+                    lo = min(lo, pre[v]);
+                    hi = max(hi, pre[v]);
+                }
+                for (int k = kidStart[u]; k < kidStart[u + 1]; ++k) {
+                    lo = min(lo, lowPre[kids[k]]);
+                    hi = max(hi, highPre[kids[k]]);
+                }
+                lowPre[u] = lo;
+                highPre[u] = hi;
+            });
+
+        // 5. ͼ (par[v], v)  v ʾķ˵ߣ
+        //     v зڵ p ʱ(p, v)  (par[p], p) ͬһ
+        ConcurrentDSU aux(n);
+        parallelFor(threads, n, CHUNK, [&](size_t lo, size_t hi) {
+            for (size_t k = lo; k < hi; ++k) {
+                int u = (int)k;
+                for (int64_t i = adj.offset[u]; i < adj.offset[u + 1]; ++i) {
+                    int v = adj.target[i];
+                    if (pre[u] < pre[v] && pre[v] >= pre[u] + sz[u] && !isTree(u, v)) aux.unite(u, v);
+                }
+                int p = par[u];
+                if (p == u || par[p] == p) continue;
+                if (lowPre[u] < pre[p] || highPre[u] >= pre[p] + sz[p]) aux.unite(u, p);
+            }
+        });
+
+        // 6. ȡӶ˵㣬ȡŽϴĶ˵
+        auto repOf = [&](int a, int b) {
+            if (par[b] == a) return b;
+            if (par[a] == b) return a;
+            return pre[a] > pre[b] ? a : b;
+        };
+        vector<int> id(n, -1);
+        for (int v = 0; v < n; ++v)
+            if (par[v] != v && aux.find(v) == v) id[v] = numComps++;
+        if (fromCSR) {
+            edgeComp.assign(adj.edgeCount(), -1);
+            parallelFor(threads, n, CHUNK, [&](size_t lo, size_t hi) {
+                for (size_t u = lo; u < hi; ++u)
+                    for (int64_t i = adj.offset[u]; i < adj.offset[u + 1]; ++i)
+                        if (adj.target[i] != (int)u) edgeComp[i] = id[aux.find(repOf((int)u, adj.target[i]))];
+            });
+        } else {
+            edgeComp.assign(edges.size(), -1);
+            parallelFor(threads, edges.size(), CHUNK, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    int u = edges[i].u, v = edges[i].v;
+                    if (u != v) edgeComp[i] = id[aux.find(repOf(u, v))];
+                }
+            });
+        }
+
+        // 7. ؽڵ㣺ڱ߷Ϸţûκη
+        parallelFor(threads, n, CHUNK, [&](size_t lo, size_t hi) {
+            for (size_t k = lo; k < hi; ++k) {
+                int u = (int)k, first = -1;
+                for (int64_t i = adj.offset[u]; i < adj.offset[u + 1]; ++i) {
+                    int v = adj.target[i];
+                    if (v == u) continue;
+                    int c = aux.find(repOf(u, v));
+                    if (first < 0) first = c;
+                    else if (c != first) { markArticulation(u); break; }
+                }
+            }
+        });
+        for (int v = 0; v < n; ++v)
+            if (par[v] != v && lowPre[v] >= pre[v] && highPre[v] < pre[v] + sz[v]) bridges.push_back({par[v], v});
+    }
+
     void printResults(const vector<string>& labels) {
         cout << "ؽڵ (Articulation Points):\n";
-        if (articulationPoints.empty()) {
-            cout << "\n";
-        } else {
-            for (int ap : articulationPoints) {
-                cout << labels[ap] << " ";
+        bool any = false;
+        for (int v = 0; v < n; ++v) {
+            if (isArticulation(v)) {
+                cout << labels[v] << " ";
+                any = true;
             }
-            cout << "\n";
         }
+        cout << (any ? "\n" : "\n");
 
         cout << "˫ͨ (Biconnected Components):\n";
-        for (size_t i = 0; i < bcc.size(); ++i) {
-            cout << "Component " << i+1 << ": ";
-            for (auto& e : bcc[i]) {
-                cout << "(" << labels[e.first] << "," << labels[e.second] << ") ";
+        for (int c = 0; c + 1 < (int)compStart.size(); ++c) {
+            cout << "Component " << c+1 << ": ";
+            for (int k = compStart[c]; k < compStart[c + 1]; ++k) {
+                cout << "(" << labels[compEdges[k].first] << "," << labels[compEdges[k].second] << ") ";
             }
             cout << "\n";
         }
     }
 };
 
+// ========================
+// ģϡͼ
+// ========================
+template <typename F>
+double timeMs(F f) {
+    auto start = chrono::high_resolution_clock::now();
+    f();
+    auto end = chrono::high_resolution_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// ͼn 㣬ƽ avgDegȨ 1~100̶ӱڸ
+vector<Edge> randomEdges(int n, int avgDeg, unsigned seed = 42) {
+    mt19937 gen(seed);
+    uniform_int_distribution<int> vert(0, n - 1), wt(1, 100);
+    vector<Edge> edges((size_t)n * avgDeg / 2);
+    for (Edge& e : edges) e = {vert(gen), vert(gen), wt(gen)};
+    return edges;
+}
+
+void benchLargeGraph(int n, int avgDeg) {
+    vector<Edge> edges = randomEdges(n, avgDeg);
+    Graph g(0);
+    double tb = timeMs([&] { g = Graph(n, edges); });
+    double csrMB = ((g.n + 1) * 8.0 + g.csr.edgeCount() * 8.0) / 1048576;
+    double denseMB = (double)n * n * sizeof(int) / 1048576;
+
+    cout << fixed << setprecision(2);
+    cout << "=== ģϡͼ: " << n << " , " << edges.size() << "  ===\n";
+    cout << "CSR : " << tb << " ms, ռ " << csrMB << " MBڽӾ " << denseMB << " MB\n";
+
+    size_t reached = 0;
+    long long far = 0, total = 0;
+    double t1 = timeMs([&] { reached = g.bfsOrder(0).size(); });
+    double t2 = timeMs([&] {
+        for (long long d : g.shortestPaths({0}).dist) if (d != LLONG_MAX) far = max(far, d);
+    });
+    double t3 = timeMs([&] { for (const Edge& e : g.primEdges()) total += e.w; });
+    cout << "BFS:      " << t1 << " msɴ " << reached << " 㣩\n";
+    cout << "Dijkstra: " << t2 << " msԶ " << far << "\n";
+    cout << "Prim:     " << t3 << " msɭȨ " << total << "\n";
+}
+
+// ȶе Dijkstra ԱȣԵĿǰԴѯ
+void benchShortestPaths(int n, int avgDeg) {
+    Graph g(n, randomEdges(n, avgDeg));
+    const char* names[] = {"BinaryHeap", "4-aryHeap", "RadixHeap"};
+    PQKind kinds[] = {PQKind::BinaryHeap, PQKind::QuaryHeap, PQKind::RadixHeap};
+
+    cout << fixed << setprecision(2);
+    cout << "=== Dijkstra ȶжԱ: " << n << " , ƽ " << avgDeg << " ===\n";
+    ShortestPaths ref;
+    for (int k = 0; k < 3; ++k) {
+        ShortestPaths sp;
+        double t = timeMs([&] { sp = g.shortestPaths({0}, kinds[k]); });
+        if (k == 0) ref = sp;
+        cout << "  " << setw(10) << names[k] << ": " << setw(9) << t << " ms"
+             << (sp.dist == ref.dist ? "" : "  [MISMATCH]") << "\n";
+    }
+
+    // Ŀ꣺ѡ 20 Ŀ꣬ǰӦһ
+    mt19937 gen(7);
+    uniform_int_distribution<int> vert(0, n - 1);
+    bool same = true;
+    double te = 0;
+    int queries = 20;
+    for (int q = 0; q < queries; ++q) {
+        int t = vert(gen);
+        ShortestPaths sp;
+        te += timeMs([&] { sp = g.shortestPaths({0}, PQKind::RadixHeap, t); });
+        same = same && sp.dist[t] == ref.dist[t] && (sp.path(t).empty() || sp.path(t).back() == t);
+    }
+    cout << "  Ŀǰ: ƽ " << te / queries << " ms/" << (same ? "" : "  [MISMATCH]") << "\n";
+
+    vector<int> sources;
+    for (int i = 0; i < 16; ++i) sources.push_back(vert(gen));
+    ShortestPaths multi;
+    double tm = timeMs([&] { multi = g.shortestPaths(sources, PQKind::RadixHeap); });
+    long long far = 0;
+    for (long long d : multi.dist) if (d != LLONG_MAX) far = max(far, d);
+    cout << "  16 Դѯ: " << tm << " msԴԶ " << far << "\n";
+}
+
+//  BFS 봮 BFS ĲŶԱȣУ鸸ڵ
+void benchParallelBFS(int n, int avgDeg, int threads) {
+    Graph g(n, randomEdges(n, avgDeg));
+    if (threads <= 0) threads = (int)max(1u, thread::hardware_concurrency());
+
+    vector<int> ref(n, -1);
+    double ts = timeMs([&] {
+        vector<int> order = g.bfsOrder(0);
+        ref[0] = 0;
+        for (int u : order)
+            for (int64_t i = g.csr.offset[u]; i < g.csr.offset[u + 1]; ++i)
+                if (ref[g.csr.target[i]] < 0) ref[g.csr.target[i]] = ref[u] + 1;
+    });
+
+    cout << fixed << setprecision(2);
+    cout << "===  BFS: " << n << " , " << g.csr.edgeCount() / 2 << "  ===\n";
+    cout << "   BFS:        " << setw(9) << ts << " ms\n";
+    vector<int> counts = {1};
+    if (threads > 1) counts.push_back(threads);
+    for (int t : counts) {
+        BFSResult r;
+        double tp = timeMs([&] { r = g.parallelBFS(0, t); });
+        bool ok = r.level == ref;
+        for (int v = 0; v < n && ok; ++v) {
+            int p = r.parent[v];
+            if (v == 0 || p < 0) continue;
+            ok = r.level[p] == r.level[v] - 1 && g.csr.weightOf(p, v) > 0;
+        }
+        cout << "  Ż " << setw(2) << t << " ߳: " << setw(9) << tp << " ms, "
+             << g.csr.edgeCount() / (tp * 1000) << " MTEPSԶ " << r.topDownSteps
+             << " 㣬Ե " << r.bottomUpSteps << " 㣩" << (ok ? "" : "  [MISMATCH]") << "\n";
+    }
+}
+
+// ˫ͨʽջ Tarjan 벢 TarjanCVishkin Աȣóջ
+void benchBiconnected(int n, int avgDeg, int threads) {
+    cout << fixed << setprecision(2);
+    cout << "=== ˫ͨ: " << n << " , ƽ " << avgDeg << " ===\n";
+    Biconnected seq(n), par(n);
+    for (const Edge& e : randomEdges(n, avgDeg)) {
+        seq.addEdge(e.u, e.v);
+        par.addEdge(e.u, e.v);
+    }
+    double tb = timeMs([&] { seq.findBridges(); });
+    double ts = timeMs([&] { seq.findBCC(); });
+    double tp = timeMs([&] { par.parallelBCC(threads); });
+
+    // ֻһһӦ
+    bool ok = seq.numComps == par.numComps && seq.articulation == par.articulation;
+    vector<int> mapTo(seq.numComps, -1);
+    for (size_t i = 0; i < seq.edges.size() && ok; ++i) {
+        int a = seq.edgeComp[i], b = par.edgeComp[i];
+        if (a < 0 || b < 0) { ok = a == b; continue; }
+        if (mapTo[a] < 0) mapTo[a] = b;
+        ok = mapTo[a] == b;
+    }
+    auto norm = [](vector<pair<int,int>> v) {
+        for (auto& e : v) if (e.first > e.second) swap(e.first, e.second);
+        sort(v.begin(), v.end());
+        return v;
+    };
+    ok = ok && norm(seq.bridges) == norm(par.bridges);
+    int aps = 0;
+    for (int v = 0; v < n; ++v) aps += seq.isArticulation(v);
+
+    cout << "  Tarjanʽջ:   " << setw(9) << ts << " ms" << seq.numComps << " , "
+         << aps << " ؽڵ, " << seq.bridges.size() << " ţ\n";
+    cout << "  :             " << setw(9) << tb << " ms\n";
+    cout << "  TarjanCVishkin:     " << setw(9) << tp << " ms" << (ok ? "" : "  [MISMATCH]") << "\n";
+
+    // ݹԼ 10 ʱջ
+    int len = max(n, 1000000);
+    Biconnected chain(len);
+    for (int v = 0; v + 1 < len; ++v) chain.addEdge(v, v + 1);
+    double tc = timeMs([&] { chain.findBCC(); });
+    cout << "  " << len << " 㳤: " << tc << " ms" << chain.numComps << " "
+         << (chain.numComps == len - 1 ? "" : "  [MISMATCH]") << "\n";
+}
+
+// Сɭ֣Prim / Kruskal /  Boruvka Ա
+void benchMST(int n, int avgDeg, int threads) {
+    Graph g(n, randomEdges(n, avgDeg));
+    if (threads <= 0) threads = (int)max(1u, thread::hardware_concurrency());
+    cout << fixed << setprecision(2);
+    cout << "=== Сɭ: " << n << " , " << g.csr.edgeCount() / 2 << "  ===\n";
+
+    long long primTotal = 0;
+    size_t primCount = 0;
+    double tp = timeMs([&] {
+        vector<Edge> tree = g.primEdges();
+        primCount = tree.size();
+        for (const Edge& e : tree) primTotal += e.w;
+    });
+    cout << "  Prim:              " << setw(9) << tp << " msȨ " << primTotal << ", " << primCount << " ߣ\n";
+
+    SpanningForest k;
+    double tk = timeMs([&] { k = g.kruskalMST(); });
+    cout << "  Kruskal:           " << setw(9) << tk << " ms" << k.components << " "
+         << (k.total == primTotal && k.edges.size() == primCount ? "" : "  [MISMATCH]") << "\n";
+
+    vector<int> counts = {1};
+    if (threads > 1) counts.push_back(threads);
+    for (int t : counts) {
+        SpanningForest b;
+        double tb = timeMs([&] { b = g.boruvkaMST(t); });
+        // ƽֹͬ߼ҲӦȫһ
+        auto key = [](const Edge& a, const Edge& b) { return a.u != b.u ? a.u < b.u : a.v < b.v; };
+        vector<Edge> x = k.edges, y = b.edges;
+        sort(x.begin(), x.end(), key);
+        sort(y.begin(), y.end(), key);
+        bool same = x.size() == y.size() && b.total == k.total;
+        for (size_t i = 0; same && i < x.size(); ++i) same = x[i].u == y[i].u && x[i].v == y[i].v;
+        cout << "  Boruvka " << setw(2) << t << " ߳:   " << setw(9) << tb << " ms" << (same ? "" : "  [MISMATCH]") << "\n";
+    }
+}
+
+// ı߱  CSR 
+int convertEdgeList(const char* in, const char* out, int threads) {
+    int n = 0;
+    vector<Edge> edges;
+    CSR g;
+    double tr = timeMs([&] {
+        if (!readEdgeList(in, n, edges, threads)) n = -1;
+    });
+    if (n < 0) {
+        cerr << "޷ȡ߱: " << in << "\n";
+        return 1;
+    }
+    double tb = timeMs([&] { g.build(n, edges, true); });
+    bool ok = false;
+    double tw = timeMs([&] { ok = g.save(out); });
+    if (!ok) {
+        cerr << "޷д: " << out << "\n";
+        return 1;
+    }
+    cout << fixed << setprecision(2);
+    cout << n << " , " << edges.size() << " б, CSR  " << g.edgeCount() << " \n";
+    cout << ": " << tr << " ms, : " << tb << " ms, д: " << tw << " ms\n";
+    return 0;
+}
+
+// ӳպֱܲ BFS ˫ͨverify ΪʱУ
+int openSnapshot(const char* path, int threads, bool verify = true) {
+    CSR g;
+    bool ok = false;
+    double tl = timeMs([&] { ok = g.load(path); });
+    if (!ok) {
+        cerr << "ЧĿļ: " << path << "\n";
+        return 1;
+    }
+    cout << fixed << setprecision(2);
+    cout << g.n << " , " << g.edgeCount() << " , ӳʱ " << tl << " ms\n";
+    if (verify) {
+        double tv = timeMs([&] { ok = g.validate(); });
+        if (!ok) {
+            cerr << "ձ: " << path << "\n";
+            return 1;
+        }
+        cout << "У: " << tv << " ms\n";
+    }
+    if (g.n == 0) return 0;
+
+    Graph graph(g);
+    BFSResult r;
+    double tb = timeMs([&] { r = graph.parallelBFS(0, threads); });
+    int reached = 0;
+    for (int l : r.level) reached += l >= 0;
+    cout << " BFS: " << tb << " ms 0 ɴ " << reached << " 㣩\n";
+
+    Biconnected bc(g);
+    double tc = timeMs([&] { bc.parallelBCC(threads); });
+    int aps = 0;
+    for (int v = 0; v < g.n; ++v) aps += bc.isArticulation(v);
+    cout << "˫ͨ: " << tc << " ms" << bc.numComps << " , " << aps << " ؽڵ㣩\n";
+    return 0;
+}
+
 // ========================
 // 
 // ========================
-int main() {
+// ÷exp3                      ͼ1ͼ2 ʾ
+//       exp3 -big [] [ƽ] ģϡͼ
+//       exp3 -sssp [] [ƽ] Dijkstra ȶжԱ
+//       exp3 -bfs [] [ƽ] [߳] зŻ BFS
+//       exp3 -bcc [] [ƽ] [߳] ˫ͨ / У
+//       exp3 -mst [] [ƽ] [߳] Сɭ֣Prim / Kruskal / Boruvka
+//       exp3 -convert <߱> <> [߳] ı߱SNAP / DIMACSתΪ CSR 
+//       exp3 -open <> [߳] [-noverify] ӳղв BFS˫ͨ
+//                                       ĬУ飬-noverify ԼɵĿգ
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && strcmp(argv[1], "-big") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 1000000;
+        int deg = argc >= 4 ? atoi(argv[3]) : 8;
+        benchLargeGraph(max(n, 1), max(deg, 1));
+        return 0;
+    }
+    if (argc >= 2 && strcmp(argv[1], "-sssp") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 1000000;
+        int deg = argc >= 4 ? atoi(argv[3]) : 8;
+        benchShortestPaths(max(n, 1), max(deg, 1));
+        return 0;
+    }
+    if (argc >= 2 && strcmp(argv[1], "-bfs") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 1000000;
+        int deg = argc >= 4 ? atoi(argv[3]) : 16;
+        benchParallelBFS(max(n, 1), max(deg, 1), argc >= 5 ? atoi(argv[4]) : 0);
+        return 0;
+    }
+    if (argc >= 2 && strcmp(argv[1], "-bcc") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 1000000;
+        int deg = argc >= 4 ? atoi(argv[3]) : 3;
+        benchBiconnected(max(n, 1), max(deg, 1), argc >= 5 ? atoi(argv[4]) : 0);
+        return 0;
+    }
+    if (argc >= 2 && strcmp(argv[1], "-mst") == 0) {
+        int n = argc >= 3 ? atoi(argv[2]) : 1000000;
+        int deg = argc >= 4 ? atoi(argv[3]) : 16;
+        benchMST(max(n, 1), max(deg, 1), argc >= 5 ? atoi(argv[4]) : 0);
+        return 0;
+    }
+    if (argc >= 4 && strcmp(argv[1], "-convert") == 0) {
+        return convertEdgeList(argv[2], argv[3], argc >= 5 ? atoi(argv[4]) : 0);
+    }
+    if (argc >= 3 && strcmp(argv[1], "-open") == 0) {
+        bool verify = !(argc >= 5 && strcmp(argv[4], "-noverify") == 0);
+        return openSnapshot(argv[2], argc >= 4 ? atoi(argv[3]) : 0, verify);
+    }
+
     // ========== ͼ1Ȩͼ ==========
     vector<string> labels1 = {"A", "B", "C", "D", "E"};
     Graph g1(5, labels1);
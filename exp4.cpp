@@ -6,6 +6,32 @@
 #include <cmath>
 #include <functional>
 #include <iomanip>
+#include <cstring>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cassert>
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SIMD_X86 1
+#else
+#define SIMD_X86 0
+#endif
 
 struct BBox {
     float x1, y1, x2, y2, score;
@@ -22,20 +48,25 @@ struct BBox {
 // 㷨ʵ
 // ==============================
 
+// ·֣[low, lt) ᣬ[lt, gt] ȣ(gt, high] ᣬ
+// ֿͬȫ䵽ͬһࡣֻԽ϶̵һݹ顢ϳһѭݹ O(log n)
 void quickSort(std::vector<BBox>& arr, int low, int high) {
-    if (low >= high) return;
-    float pivot = arr[high].score;
-    int i = low - 1;
-    for (int j = low; j < high; ++j) {
-        if (arr[j].score >= pivot) {
-            ++i;
-            std::swap(arr[i], arr[j]);
+    while (low < high) {
+        float pivot = arr[low + (high - low) / 2].score;
+        int lt = low, i = low, gt = high;
+        while (i <= gt) {
+            if (arr[i].score > pivot) std::swap(arr[lt++], arr[i++]);
+            else if (arr[i].score < pivot) std::swap(arr[i], arr[gt--]);
+            else ++i;
+        }
+        if (lt - low < high - gt) {
+            quickSort(arr, low, lt - 1);
+            low = gt + 1;
+        } else {
+            quickSort(arr, gt + 1, high);
+            high = lt - 1;
         }
     }
-    std::swap(arr[i + 1], arr[high]);
-    int pi = i + 1;
-    quickSort(arr, low, pi - 1);
-    quickSort(arr, pi + 1, high);
 }
 void quickSortWrapper(std::vector<BBox>& arr) {
     if (!arr.empty()) quickSort(arr, 0, arr.size() - 1);
@@ -104,14 +135,141 @@ void bubbleSort(std::vector<BBox>& arr) {
     }
 }
 
+// ȶֵĿ nth_element ѡߵ k ֻ k 
+// ֻ k 򡪡NMS ֻҪ
+void topKSort(std::vector<BBox>& arr, size_t k, float scoreThreshold = -INFINITY) {
+    auto desc = [](const BBox& a, const BBox& b) { return a.score > b.score; };
+    arr.erase(std::remove_if(arr.begin(), arr.end(), [&](const BBox& b) { return b.score < scoreThreshold; }),
+              arr.end());
+    if (k < arr.size()) {
+        std::nth_element(arr.begin(), arr.begin() + k, arr.end(), desc);
+        arr.resize(k);
+    }
+    std::sort(arr.begin(), arr.end(), desc);
+}
+
+// ӳΪ޷򼴷+0  -0 Ϊ
+static inline uint32_t descendingKey(float f) {
+    if (f == 0.0f) f = 0.0f;
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    u = (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+    return ~u;
+}
+
+// LSD 򣺶 (, ±)  11/11/10 λȶ䣬±һſ
+// мͬһͰ mergeSort һȶĽ
+void radixSortByScore(std::vector<BBox>& arr) {
+    size_t n = arr.size();
+    if (n < 2) return;
+    std::vector<uint32_t> key(n), idx(n), key2(n), idx2(n);
+    for (size_t i = 0; i < n; ++i) {
+        key[i] = descendingKey(arr[i].score);
+        idx[i] = (uint32_t)i;
+    }
+    const int shifts[] = {0, 11, 22};
+    std::vector<size_t> count(2048);
+    for (int shift : shifts) {
+        std::fill(count.begin(), count.end(), 0);
+        for (size_t i = 0; i < n; ++i) count[(key[i] >> shift) & 2047]++;
+        if (count[(key[0] >> shift) & 2047] == n) continue;
+        size_t sum = 0;
+        for (size_t& c : count) {
+            size_t t = c;
+            c = sum;
+            sum += t;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            size_t pos = count[(key[i] >> shift) & 2047]++;
+            key2[pos] = key[i];
+            idx2[pos] = idx[i];
+        }
+        key.swap(key2);
+        idx.swap(idx2);
+    }
+    std::vector<BBox> out(n);
+    for (size_t i = 0; i < n; ++i) out[i] = arr[idx[i]];
+    arr.swap(out);
+}
+
+// 򣺵Ⱦѡ̶ֵָ߳ԼĿͳƲȶ䵽Ͱ
+// Ͱ̶̬߳ȡ stable_sortֿͬͬһͰȶĽ
+void sampleSort(std::vector<BBox>& arr, int threads = 0) {
+    auto desc = [](const BBox& a, const BBox& b) { return a.score > b.score; };
+    if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    size_t n = arr.size();
+    if (threads == 1 || n < (1u << 16)) {
+        std::stable_sort(arr.begin(), arr.end(), desc);
+        return;
+    }
+
+    int buckets = threads * 4;
+    std::vector<float> sample;
+    for (int i = 0; i < buckets * 32; ++i) sample.push_back(arr[(size_t)i * n / (buckets * 32)].score);
+    std::sort(sample.begin(), sample.end(), std::greater<float>());
+    std::vector<float> splitters;
+    for (int b = 1; b < buckets; ++b) splitters.push_back(sample[b * 32]);
+
+    // Ͱ = Сڸ÷ķֵָԽͰԽС
+    std::vector<uint16_t> bucketOf(n);
+    std::vector<size_t> count((size_t)threads * buckets, 0);
+    auto chunkRange = [&](int t, size_t& lo, size_t& hi) {
+        lo = n * t / threads;
+        hi = n * (t + 1) / threads;
+    };
+    auto runAll = [&](std::function<void(int)> f) {
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; ++t) pool.emplace_back(f, t);
+        f(0);
+        for (auto& th : pool) th.join();
+    };
+    runAll([&](int t) {
+        size_t lo, hi;
+        chunkRange(t, lo, hi);
+        for (size_t i = lo; i < hi; ++i) {
+            int b = (int)(std::upper_bound(splitters.begin(), splitters.end(), arr[i].score, std::greater<float>()) -
+                          splitters.begin());
+            bucketOf[i] = (uint16_t)b;
+            count[(size_t)t * buckets + b]++;
+        }
+    });
+
+    //  (Ͱ, ߳) ˳ǰ׺֤ͣȶ
+    std::vector<size_t> bucketStart(buckets + 1, 0);
+    size_t sum = 0;
+    for (int b = 0; b < buckets; ++b) {
+        bucketStart[b] = sum;
+        for (int t = 0; t < threads; ++t) {
+            size_t c = count[(size_t)t * buckets + b];
+            count[(size_t)t * buckets + b] = sum;
+            sum += c;
+        }
+    }
+    bucketStart[buckets] = n;
+
+    std::vector<BBox> out(n);
+    runAll([&](int t) {
+        size_t lo, hi;
+        chunkRange(t, lo, hi);
+        size_t* pos = &count[(size_t)t * buckets];
+        for (size_t i = lo; i < hi; ++i) out[pos[bucketOf[i]]++] = arr[i];
+    });
+    std::atomic<int> next(0);
+    runAll([&](int) {
+        for (int b; (b = next.fetch_add(1)) < buckets;)
+            std::stable_sort(out.begin() + bucketStart[b], out.begin() + bucketStart[b + 1], desc);
+    });
+    arr.swap(out);
+}
+
 // ==============================
 // ߽ɺ
 // ==============================
 
-std::vector<BBox> generateRandomBoxes(int n) {
+// ̶ӣͬһÿͬĿ򣬱ڸֺͶԱ
+std::vector<BBox> generateRandomBoxes(int n, unsigned seed = 42) {
     std::vector<BBox> boxes;
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(seed);
     std::uniform_real_distribution<float> coord(0.0f, 900.0f);
     std::uniform_real_distribution<float> size(10.0f, 100.0f);
     std::uniform_real_distribution<float> score(0.0f, 1.0f);
@@ -128,10 +286,9 @@ std::vector<BBox> generateRandomBoxes(int n) {
     return boxes;
 }
 
-std::vector<BBox> generateClusteredBoxes(int n, int clusters) {
+std::vector<BBox> generateClusteredBoxes(int n, int clusters, unsigned seed = 42) {
     std::vector<BBox> boxes;
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(seed);
     std::uniform_real_distribution<float> center(200.0f, 800.0f);
     std::uniform_real_distribution<float> offset(-50.0f, 50.0f);
     std::uniform_real_distribution<float> size(10.0f, 60.0f);
@@ -207,6 +364,623 @@ std::vector<BBox> nms(const std::vector<BBox>& boxes, float iou_threshold = 0.5f
     return result;
 }
 
+// ռ NMS nms һ˳̰ġ computeIoU жλͬ
+// ÿֻռཻѱȽϣȫѱȽϡ
+// ѱǼǵǵÿӣϹ䣩
+// ǸӹĴ򵥶Ž large бÿζ顣
+// رе±
+std::vector<int> nmsGridIndices(const std::vector<BBox>& boxes, float iou_threshold = 0.5f) {
+    std::vector<int> result;
+    if (boxes.empty()) return result;
+    // ֵΪʱཻĿҲụƣ޴Ӽ֦˻ԱȽ
+    if (!(iou_threshold >= 0.0f)) {
+        for (size_t j = 0; j < boxes.size(); ++j) {
+            bool suppressed = false;
+            for (size_t k = 0; k < result.size() && !suppressed; ++k)
+                suppressed = computeIoU(boxes[result[k]], boxes[j]) > iou_threshold;
+            if (!suppressed) result.push_back((int)j);
+        }
+        return result;
+    }
+
+    // ֻпΪĿſཻĿضҲƱĿ
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    double sumW = 0, sumH = 0;
+    size_t valid = 0;
+    for (const BBox& b : boxes) {
+        if (!(b.x2 > b.x1 && b.y2 > b.y1)) continue;
+        if (valid == 0) {
+            minX = b.x1; minY = b.y1; maxX = b.x2; maxY = b.y2;
+        }
+        minX = std::min(minX, b.x1); minY = std::min(minY, b.y1);
+        maxX = std::max(maxX, b.x2); maxY = std::max(maxY, b.y2);
+        sumW += b.x2 - b.x1;
+        sumH += b.y2 - b.y1;
+        ++valid;
+    }
+    if (valid == 0) {
+        for (size_t j = 0; j < boxes.size(); ++j) result.push_back((int)j);
+        return result;
+    }
+
+    // ӱ߳ȡƽߣ 2^20
+    const int MAX_SIDE = 1024;
+    const int LARGE_SPAN = 64;
+    double spanX = std::max((double)maxX - minX, 1e-6), spanY = std::max((double)maxY - minY, 1e-6);
+    int gx = (int)std::min<double>(MAX_SIDE, std::max(1.0, std::ceil(spanX / (sumW / valid))));
+    int gy = (int)std::min<double>(MAX_SIDE, std::max(1.0, std::ceil(spanY / (sumH / valid))));
+    float invW = (float)(gx / spanX), invH = (float)(gy / spanY);
+    auto cellX = [&](float x) { return std::min(gx - 1, std::max(0, (int)((x - minX) * invW))); };
+    auto cellY = [&](float y) { return std::min(gy - 1, std::max(0, (int)((y - minY) * invH))); };
+
+    std::vector<int> head((size_t)gx * gy, -1), next, owner;   // 
+    std::vector<int> large;                                     // Ǹӹѱ
+    std::vector<int> seen(boxes.size(), -1);                    // ͬһѡֻȽһ
+
+    for (size_t j = 0; j < boxes.size(); ++j) {
+        const BBox& b = boxes[j];
+        if (!(b.x2 > b.x1 && b.y2 > b.y1)) {
+            result.push_back((int)j);
+            continue;
+        }
+        int cx0 = cellX(b.x1), cx1 = cellX(b.x2), cy0 = cellY(b.y1), cy1 = cellY(b.y2);
+        bool suppressed = false;
+        for (size_t k = 0; k < large.size() && !suppressed; ++k)
+            suppressed = computeIoU(boxes[large[k]], b) > iou_threshold;
+        for (int cy = cy0; cy <= cy1 && !suppressed; ++cy) {
+            for (int cx = cx0; cx <= cx1 && !suppressed; ++cx) {
+                for (int e = head[(size_t)cy * gx + cx]; e >= 0; e = next[e]) {
+                    int i = owner[e];
+                    if (seen[i] == (int)j) continue;
+                    seen[i] = (int)j;
+                    if (computeIoU(boxes[i], b) > iou_threshold) {
+                        suppressed = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (suppressed) continue;
+
+        result.push_back((int)j);
+        if ((int64_t)(cx1 - cx0 + 1) * (cy1 - cy0 + 1) > LARGE_SPAN) {
+            large.push_back((int)j);
+            continue;
+        }
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                size_t c = (size_t)cy * gx + cx;
+                next.push_back(head[c]);
+                owner.push_back((int)j);
+                head[c] = (int)owner.size() - 1;
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<BBox> nmsGrid(const std::vector<BBox>& boxes, float iou_threshold = 0.5f) {
+    std::vector<BBox> result;
+    for (int i : nmsGridIndices(boxes, iou_threshold)) result.push_back(boxes[i]);
+    return result;
+}
+
+// ֶΡλȽ
+bool sameBoxes(const std::vector<BBox>& a, const std::vector<BBox>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (std::memcmp(&a[i], &b[i], sizeof(BBox)) != 0) return false;
+    return true;
+}
+
+// ==============================
+// ṹ SIMD 
+// ==============================
+
+// ṹʽĿΣֶηֿţ 64 ֽڶ벢뵽 64 ı
+// 벿ǿΪ 0 Ŀտκο IoU Ϊ 0
+struct BoxBatch {
+    size_t n;        // ʵʿ
+    size_t padded;   // ĳȣ64 ıӦ
+    float* x1;
+    float* y1;
+    float* x2;
+    float* y2;
+    float* score;
+    float* area;     //  computeIoU ͬʽԤ
+
+    explicit BoxBatch(const std::vector<BBox>& boxes)
+        : n(boxes.size()), padded((boxes.size() + 63) / 64 * 64), storage(6 * padded + 16, 0.0f) {
+        float* base = storage.data();
+        base += (64 - (reinterpret_cast<uintptr_t>(base) & 63)) / sizeof(float) % 16;
+        float** fields[] = {&x1, &y1, &x2, &y2, &score, &area};
+        for (int f = 0; f < 6; ++f) *fields[f] = base + f * padded;
+        for (size_t i = 0; i < n; ++i) {
+            const BBox& b = boxes[i];
+            x1[i] = b.x1; y1[i] = b.y1; x2[i] = b.x2; y2[i] = b.y2; score[i] = b.score;
+            area[i] = (b.x2 - b.x1) * (b.y2 - b.y1);
+        }
+    }
+    BoxBatch(const BoxBatch&) = delete;
+    BoxBatch& operator=(const BoxBatch&) = delete;
+
+private:
+    std::vector<float> storage;
+};
+
+enum class SimdLevel { Scalar, AVX2, AVX512 };
+
+const char* simdName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::AVX512: return "AVX-512";
+    case SimdLevel::AVX2: return "AVX2";
+    default: return "Scalar";
+    }
+}
+
+// ʱõָ GCC/Clang  x86 ƽֻ̨ñ汾
+SimdLevel detectSimd() {
+#if SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+// ںˣ i  w0 .. w1-1 ֶӦ 64 * (w1 - w0)  IoU
+// IoU > ֵλ out[w] computeIoU ˳򣬽֮λͬ
+// max/min Ĳ˳ std::max/std::min  NaN Ĵһ£Ҳ˼ںϣ
+using RowKernel = void (*)(const BoxBatch&, size_t, size_t, size_t, float, uint64_t*);
+
+static void suppressRowScalar(const BoxBatch& b, size_t i, size_t w0, size_t w1, float thr, uint64_t* out) {
+    for (size_t w = w0; w < w1; ++w) {
+        uint64_t bits = 0;
+        for (size_t k = 0; k < 64; ++k) {
+            size_t j = w * 64 + k;
+            float ix1 = std::max(b.x1[i], b.x1[j]);
+            float iy1 = std::max(b.y1[i], b.y1[j]);
+            float ix2 = std::min(b.x2[i], b.x2[j]);
+            float iy2 = std::min(b.y2[i], b.y2[j]);
+            float iou = 0.0f;
+            if (!(ix1 >= ix2 || iy1 >= iy2)) {
+                float inter = (ix2 - ix1) * (iy2 - iy1);
+                iou = inter / (b.area[i] + b.area[j] - inter);
+            }
+            bits |= (uint64_t)(iou > thr) << k;
+        }
+        out[w] |= bits;
+    }
+}
+
+#if SIMD_X86
+__attribute__((target("avx2")))
+static void suppressRowAVX2(const BoxBatch& b, size_t i, size_t w0, size_t w1, float thr, uint64_t* out) {
+    const __m256 ax1 = _mm256_set1_ps(b.x1[i]), ay1 = _mm256_set1_ps(b.y1[i]);
+    const __m256 ax2 = _mm256_set1_ps(b.x2[i]), ay2 = _mm256_set1_ps(b.y2[i]);
+    const __m256 aarea = _mm256_set1_ps(b.area[i]), t = _mm256_set1_ps(thr);
+    for (size_t w = w0; w < w1; ++w) {
+        uint64_t bits = 0;
+        for (size_t k = 0; k < 64; k += 8) {
+            size_t j = w * 64 + k;
+            // _mm256_max_ps(x, y) = x > y ? x : yʰѺѡǰԸ std::max(a, b)
+            __m256 ix1 = _mm256_max_ps(_mm256_load_ps(b.x1 + j), ax1);
+            __m256 iy1 = _mm256_max_ps(_mm256_load_ps(b.y1 + j), ay1);
+            __m256 ix2 = _mm256_min_ps(_mm256_load_ps(b.x2 + j), ax2);
+            __m256 iy2 = _mm256_min_ps(_mm256_load_ps(b.y2 + j), ay2);
+            __m256 empty = _mm256_or_ps(_mm256_cmp_ps(ix1, ix2, _CMP_GE_OQ), _mm256_cmp_ps(iy1, iy2, _CMP_GE_OQ));
+            __m256 inter = _mm256_mul_ps(_mm256_sub_ps(ix2, ix1), _mm256_sub_ps(iy2, iy1));
+            __m256 uni = _mm256_sub_ps(_mm256_add_ps(aarea, _mm256_load_ps(b.area + j)), inter);
+            __m256 iou = _mm256_andnot_ps(empty, _mm256_div_ps(inter, uni));
+            bits |= (uint64_t)(uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(iou, t, _CMP_GT_OQ)) << k;
+        }
+        out[w] |= bits;
+    }
+}
+
+// GCC 12  avx512fintrin.h  _mm512_undefined_ps δʼ
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+__attribute__((target("avx512f")))
+static void suppressRowAVX512(const BoxBatch& b, size_t i, size_t w0, size_t w1, float thr, uint64_t* out) {
+    const __m512 ax1 = _mm512_set1_ps(b.x1[i]), ay1 = _mm512_set1_ps(b.y1[i]);
+    const __m512 ax2 = _mm512_set1_ps(b.x2[i]), ay2 = _mm512_set1_ps(b.y2[i]);
+    const __m512 aarea = _mm512_set1_ps(b.area[i]), t = _mm512_set1_ps(thr);
+    const __m512 zero = _mm512_setzero_ps();
+    for (size_t w = w0; w < w1; ++w) {
+        uint64_t bits = 0;
+        for (size_t k = 0; k < 64; k += 16) {
+            size_t j = w * 64 + k;
+            __m512 ix1 = _mm512_max_ps(_mm512_load_ps(b.x1 + j), ax1);
+            __m512 iy1 = _mm512_max_ps(_mm512_load_ps(b.y1 + j), ay1);
+            __m512 ix2 = _mm512_min_ps(_mm512_load_ps(b.x2 + j), ax2);
+            __m512 iy2 = _mm512_min_ps(_mm512_load_ps(b.y2 + j), ay2);
+            __mmask16 empty = _mm512_cmp_ps_mask(ix1, ix2, _CMP_GE_OQ) | _mm512_cmp_ps_mask(iy1, iy2, _CMP_GE_OQ);
+            __m512 inter = _mm512_mul_ps(_mm512_sub_ps(ix2, ix1), _mm512_sub_ps(iy2, iy1));
+            // ļᱻĳ˷ںϳ FMA
+            __m512 uni = _mm512_sub_round_ps(_mm512_add_ps(aarea, _mm512_load_ps(b.area + j)), inter,
+                                             _MM_FROUND_CUR_DIRECTION);
+            __m512 iou = _mm512_mask_blend_ps(empty, _mm512_div_ps(inter, uni), zero);
+            bits |= (uint64_t)_mm512_cmp_ps_mask(iou, t, _CMP_GT_OQ) << k;
+        }
+        out[w] |= bits;
+    }
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+RowKernel rowKernel(SimdLevel level) {
+#if SIMD_X86
+    if (level == SimdLevel::AVX512) return suppressRowAVX512;
+    if (level == SimdLevel::AVX2) return suppressRowAVX2;
+#endif
+    (void)level;
+    return suppressRowScalar;
+}
+
+// GPU ƾn Сÿ padded / 64 ֣ i е j λʾ j > i  IoU(i, j) > ֵ
+// ռ n * n / 8 ֽڣʺϷֿСģ
+std::vector<uint64_t> suppressionMatrix(const BoxBatch& b, float thr, SimdLevel level) {
+    RowKernel kernel = rowKernel(level);
+    size_t words = b.padded / 64;
+    std::vector<uint64_t> mask(b.n * words, 0);
+    for (size_t i = 0; i < b.n; ++i) {
+        uint64_t* row = mask.data() + i * words;
+        size_t w0 = (i + 1) / 64;
+        kernel(b, i, w0, words, thr, row);
+        if (w0 < words) row[w0] &= ~0ULL << ((i + 1) % 64);   // ȥ j <= i λ
+    }
+    return mask;
+}
+
+// ƾ̰ģÿһͰаֻ removed
+std::vector<int> greedyFromMatrix(const std::vector<uint64_t>& mask, size_t n) {
+    size_t words = (n + 63) / 64;
+    std::vector<uint64_t> removed(words, 0);
+    std::vector<int> kept;
+    for (size_t i = 0; i < n; ++i) {
+        if ((removed[i / 64] >> (i % 64)) & 1) continue;
+        kept.push_back((int)i);
+        const uint64_t* row = mask.data() + i * words;
+        for (size_t w = i / 64; w < words; ++w) removed[w] |= row[w];
+    }
+    return kept;
+}
+
+// еλ NMSֻΪĿһУֱӻ removed
+// ȫƵj <= i λܱϣЩѾӰ
+std::vector<int> nmsBitmask(const BoxBatch& b, float thr, SimdLevel level) {
+    RowKernel kernel = rowKernel(level);
+    size_t words = b.padded / 64;
+    std::vector<uint64_t> removed(words, 0);
+    std::vector<int> kept;
+    for (size_t i = 0; i < b.n; ++i) {
+        if ((removed[i / 64] >> (i % 64)) & 1) continue;
+        kept.push_back((int)i);
+        for (size_t w = i / 64; w < words; ++w)
+            if (removed[w] != ~0ULL) kernel(b, i, w, w + 1, thr, removed.data());
+    }
+    return kept;
+}
+
+//  nms ӿһµ SIMD 汾
+std::vector<BBox> nmsSIMD(const std::vector<BBox>& boxes, float iou_threshold = 0.5f,
+                          SimdLevel level = detectSimd()) {
+    BoxBatch batch(boxes);
+    std::vector<BBox> result;
+    for (int i : nmsBitmask(batch, iou_threshold, level)) result.push_back(boxes[i]);
+    return result;
+}
+
+// ==============================
+// ȡ̳߳
+// ==============================
+
+// ÿ߳һУԼӶβȡ˾ʹӱĶж͵
+// parallelFor ĵ߳ҲռһвִУͬһʱֻһߡ
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threads = 0) : stop(false), queued(0) {
+        if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+        for (int i = 0; i < threads; ++i) queues.emplace_back(new Queue());
+        for (int i = 1; i < threads; ++i) workers.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lk(sleepMutex);
+            stop = true;
+        }
+        wake.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int size() const { return (int)queues.size(); }
+
+    // ִ f(i, ̺߳)i ȡ 0 .. count-1 grain һַȫɺ󷵻
+    template <typename F>
+    void parallelFor(size_t count, size_t grain, F f) {
+        if (count == 0) return;
+        grain = std::max<size_t>(grain, 1);
+        std::atomic<size_t> remaining((count + grain - 1) / grain);
+        Job job;
+        job.remaining = &remaining;
+        job.body = [&](size_t lo, size_t hi, int worker) {
+            for (size_t i = lo; i < hi; ++i) f(i, worker);
+        };
+        size_t q = 0;
+        for (size_t lo = 0; lo < count; lo += grain, q = (q + 1) % queues.size()) {
+            std::lock_guard<std::mutex> lk(queues[q]->mutex);
+            queues[q]->tasks.push_back({&job, lo, std::min(lo + grain, count)});
+        }
+        queued.fetch_add((count + grain - 1) / grain);
+        {
+            std::lock_guard<std::mutex> lk(sleepMutex);
+        }
+        wake.notify_all();
+        while (remaining.load() > 0)
+            if (!runOne(0)) std::this_thread::yield();
+    }
+
+private:
+    struct Job {
+        std::function<void(size_t, size_t, int)> body;
+        std::atomic<size_t>* remaining;
+    };
+    struct Task {
+        Job* job;
+        size_t lo, hi;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool stop;
+    std::atomic<size_t> queued;
+
+    bool runOne(int self) {
+        Task task = {nullptr, 0, 0};
+        int n = (int)queues.size();
+        for (int k = 0; k < n && !task.job; ++k) {
+            Queue& q = *queues[(self + k) % n];
+            std::lock_guard<std::mutex> lk(q.mutex);
+            if (q.tasks.empty()) continue;
+            if (k == 0) {
+                task = q.tasks.back();
+                q.tasks.pop_back();
+            } else {
+                task = q.tasks.front();
+                q.tasks.pop_front();
+            }
+        }
+        if (!task.job) return false;
+        queued.fetch_sub(1);
+        task.job->body(task.lo, task.hi, self);
+        task.job->remaining->fetch_sub(1);
+        return true;
+    }
+
+    void workerLoop(int self) {
+        while (true) {
+            if (runOne(self)) continue;
+            std::unique_lock<std::mutex> lk(sleepMutex);
+            wake.wait(lk, [this] { return stop || queued.load() > 0; });
+            if (stop) return;
+        }
+    }
+};
+
+// ==============================
+// ͼ NMS
+// ==============================
+
+// boxes[begin, end) ͬһͼͬһ
+struct Segment {
+    int image;
+    int cls;
+    size_t begin, end;
+};
+
+enum class NMSMode { Hard, SoftLinear, SoftGaussian };
+
+struct NMSParams {
+    float iouThreshold;
+    NMSMode mode;
+    float sigma;            // ˹ Soft-NMS ˥
+    float scoreThreshold;   // Soft-NMS зڴֵĿ
+    int topK;               // ÿΰԤɸĿ0 ʾ
+    int maxDetections;      // ÿͼĿ0 ʾ
+
+    NMSParams() : iouThreshold(0.5f), mode(NMSMode::Hard), sigma(0.5f), scoreThreshold(0.001f),
+                  topK(0), maxDetections(0) {}
+};
+
+struct Detection {
+    BBox box;     // Soft-NMS ʱ score Ϊ˥ķ
+    int image;
+    int cls;
+    int index;    //  boxes е±
+};
+
+// Ԥͼ i ĽΪ dets[imageStart[i] .. imageStart[i+1])ÿͼڰ
+struct DetectionBuffer {
+    std::vector<Detection> dets;
+    std::vector<size_t> imageStart;
+    size_t count;
+
+    DetectionBuffer() : count(0) {}
+
+    void reserve(int images, int maxPerImage) {
+        dets.resize((size_t)images * maxPerImage);
+        imageStart.reserve(images + 1);
+    }
+};
+
+// ְͬ±򣬽̵߳޹
+inline bool scoreBefore(const Detection& a, const Detection& b) {
+    if (a.box.score != b.box.score) return a.box.score > b.box.score;
+    return a.index < b.index;
+}
+
+//  NMS 棺ڹȡ̳߳ϲдٰͼϲضϡ
+// ÿ̵߳ʱ͸εмڸãֻ̬岻ʱŷ䡣
+class BatchedNMS {
+public:
+    explicit BatchedNMS(WorkStealingPool& p) : pool(p), scratch(p.size()) {}
+
+    // д out ļ
+    size_t run(const std::vector<BBox>& boxes, const std::vector<Segment>& segments,
+               const NMSParams& params, DetectionBuffer& out) {
+        int images = 0;
+        size_t total = 0;
+        segStart.resize(segments.size() + 1);
+        for (size_t s = 0; s < segments.size(); ++s) {
+            images = std::max(images, segments[s].image + 1);
+            segStart[s] = total;
+            total += segments[s].end - segments[s].begin;
+        }
+        segStart[segments.size()] = total;
+        if (kept.size() < total) kept.resize(total);
+        keptCount.assign(segments.size(), 0);
+
+        // 1. ζ NMSд kept[segStart[s] ..)
+        pool.parallelFor(segments.size(), 1, [&](size_t s, int worker) {
+            keptCount[s] = runSegment(boxes, segments[s], params, scratch[worker], &kept[segStart[s]]);
+        });
+
+        // 2. ͼ飬ÿͼ
+        imageSegStart.assign(images + 1, 0);
+        for (const Segment& seg : segments) imageSegStart[seg.image + 1]++;
+        for (int i = 0; i < images; ++i) imageSegStart[i + 1] += imageSegStart[i];
+        imageSegs.resize(segments.size());
+        {
+            std::vector<size_t>& pos = imagePos;
+            pos.assign(imageSegStart.begin(), imageSegStart.end() - 1);
+            for (size_t s = 0; s < segments.size(); ++s) imageSegs[pos[segments[s].image]++] = s;
+        }
+        out.imageStart.assign(images + 1, 0);
+        for (int i = 0; i < images; ++i) {
+            size_t k = 0;
+            for (size_t t = imageSegStart[i]; t < imageSegStart[i + 1]; ++t) k += keptCount[imageSegs[t]];
+            if (params.maxDetections > 0) k = std::min(k, (size_t)params.maxDetections);
+            out.imageStart[i + 1] = out.imageStart[i] + k;
+        }
+        out.count = out.imageStart[images];
+        if (out.dets.size() < out.count) out.dets.resize(out.count);
+
+        // 3. ÿͼϲȡߵ maxDetections 
+        pool.parallelFor(images, 1, [&](size_t i, int worker) {
+            std::vector<Detection>& all = scratch[worker].merged;
+            all.clear();
+            for (size_t t = imageSegStart[i]; t < imageSegStart[i + 1]; ++t) {
+                size_t s = imageSegs[t];
+                all.insert(all.end(), kept.begin() + segStart[s], kept.begin() + segStart[s] + keptCount[s]);
+            }
+            size_t k = out.imageStart[i + 1] - out.imageStart[i];
+            std::partial_sort(all.begin(), all.begin() + k, all.end(), scoreBefore);
+            std::copy(all.begin(), all.begin() + k, out.dets.begin() + out.imageStart[i]);
+        });
+        return out.count;
+    }
+
+private:
+    struct Scratch {
+        std::vector<int> order;
+        std::vector<BBox> boxes;
+        std::vector<float> scores;
+        std::vector<int> keptIdx;
+        std::vector<Detection> merged;
+    };
+
+    WorkStealingPool& pool;
+    std::vector<Scratch> scratch;     // ÿ߳һ
+    std::vector<Detection> kept;      // ν s  segStart[s] ʼ
+    std::vector<size_t> segStart, keptCount, imageSegStart, imageSegs, imagePos;
+
+    // ΣУȡǰ topK NMS  Soft-NMSд dst ĸ
+    static size_t runSegment(const std::vector<BBox>& all, const Segment& seg, const NMSParams& p,
+                             Scratch& sc, Detection* dst) {
+        size_t n = seg.end - seg.begin;
+        sc.order.resize(n);
+        for (size_t k = 0; k < n; ++k) sc.order[k] = (int)(seg.begin + k);
+        auto better = [&](int a, int b) {
+            if (all[a].score != all[b].score) return all[a].score > all[b].score;
+            return a < b;
+        };
+        if (p.topK > 0 && n > (size_t)p.topK) {
+            std::nth_element(sc.order.begin(), sc.order.begin() + p.topK, sc.order.end(), better);
+            n = p.topK;
+            sc.order.resize(n);
+        }
+        std::sort(sc.order.begin(), sc.order.end(), better);
+        sc.boxes.resize(n);
+        for (size_t k = 0; k < n; ++k) sc.boxes[k] = all[sc.order[k]];
+
+        size_t out = 0;
+        auto emit = [&](size_t k, float score) {
+            dst[out].box = sc.boxes[k];
+            dst[out].box.score = score;
+            dst[out].image = seg.image;
+            dst[out].cls = seg.cls;
+            dst[out].index = sc.order[k];
+            ++out;
+        };
+
+        if (p.mode == NMSMode::Hard) {
+            //  nms ̰ͬģֻͨмٸֱ뱾ѱȽϼ
+            if (n > 4096) {
+                for (int k : nmsGridIndices(sc.boxes, p.iouThreshold)) emit(k, sc.boxes[k].score);
+                return out;
+            }
+            sc.keptIdx.clear();
+            for (size_t j = 0; j < n; ++j) {
+                bool suppressed = false;
+                for (size_t t = 0; t < sc.keptIdx.size() && !suppressed; ++t)
+                    suppressed = computeIoU(sc.boxes[sc.keptIdx[t]], sc.boxes[j]) > p.iouThreshold;
+                if (suppressed) continue;
+                sc.keptIdx.push_back((int)j);
+                emit(j, sc.boxes[j].score);
+            }
+            return out;
+        }
+
+        // Soft-NMSÿȡǰߵĿ򣬰 IoU ˥ķ
+        sc.scores.resize(n);
+        for (size_t k = 0; k < n; ++k) sc.scores[k] = sc.boxes[k].score;
+        for (size_t i = 0; i < n; ++i) {
+            size_t best = i;
+            for (size_t j = i + 1; j < n; ++j)
+                if (sc.scores[j] > sc.scores[best]) best = j;
+            if (sc.scores[best] < p.scoreThreshold) break;
+            std::swap(sc.scores[i], sc.scores[best]);
+            std::swap(sc.boxes[i], sc.boxes[best]);
+            std::swap(sc.order[i], sc.order[best]);
+            emit(i, sc.scores[i]);
+            for (size_t j = i + 1; j < n; ++j) {
+                float iou = computeIoU(sc.boxes[i], sc.boxes[j]);
+                if (p.mode == NMSMode::SoftLinear) {
+                    if (iou > p.iouThreshold) sc.scores[j] *= 1.0f - iou;
+                } else {
+                    sc.scores[j] *= std::exp(-(iou * iou) / p.sigma);
+                }
+            }
+        }
+        return out;
+    }
+};
+
 // ==============================
 // Կ
 // ==============================
@@ -223,10 +997,371 @@ struct TestCase {
 struct Algorithm {
     std::string name;
     SortFunc sort_func;
-    Algorithm(const std::string& n, SortFunc f)
-        : name(n), sort_func(f) {}
+    bool parallel;   // ڲ̣߳׼ʱ
+    Algorithm(const std::string& n, SortFunc f, bool par = false)
+        : name(n), sort_func(f), parallel(par) {}
+};
+
+template <typename F>
+double timeMs(F f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// ==============================
+// ʽ NMS
+// ==============================
+
+// ֿʽ NMSһ֡Ŀ룬ɺ󼴿ȷļ
+// Լڵ飨֡Ĺ鵽Ե飩completeTile(tx, ty) ʾ
+// Ŀȫʹ߳ maxBoxSize Ŀκ֮ǰʹ
+// һֻཻ鶼ɡཻĸ߷ֿȷ
+// ֡ȫ򰴷ȶ nms λͬ
+// ĿĹҵ߳ԼΪ maxBoxSize ϣѯֻཻĸӣ
+// 򣬱ͷֵĿͣƵĿڱʱ˳ժ
+// ÿ¿ཻлмδɣǼЩϣʱֻ֪ͨǼǵĿ򣬼Ŀ򰴷
+// ÿֻɨɨȫδȷĿ򡣴ȫɺһ
+// Υ˳ĵ assert 
+// л֮֡临ãreserve ̬֮ٷ䡣
+class StreamingNMS {
+public:
+    StreamingNMS(float frameW, float frameH, int tilesX, int tilesY, float maxBoxSize, float iouThreshold = 0.5f)
+        : width(frameW), height(frameH), tilesX(std::max(1, tilesX)), tilesY(std::max(1, tilesY)),
+          maxSize(maxBoxSize), thr(iouThreshold), frame(-1), incomplete(0), frameMs(0), undecided(0),
+          latencyCount(0), growths(0), lastCapacity(0) {
+        const int MAX_SIDE = 1024;
+        float cell = std::max(maxSize, std::max(width, height) / MAX_SIDE);
+        gx = std::max(1, std::min(MAX_SIDE, (int)std::ceil(width / cell)));
+        gy = std::max(1, std::min(MAX_SIDE, (int)std::ceil(height / cell)));
+        head.assign((size_t)gx * gy, -1);
+        tileDone.assign((size_t)this->tilesX * this->tilesY, 0);
+        tileWaiters.resize(tileDone.size());
+        latency.assign(LATENCY_HISTORY, 0.0);
+        latencyScratch.reserve(LATENCY_HISTORY);
+        lastCapacity = capacity();
+    }
+
+    // ÿ֡Ԥ
+    void reserve(size_t boxesPerFrame) {
+        boxes.reserve(boxesPerFrame);
+        key.reserve(boxesPerFrame);
+        state.reserve(boxesPerFrame);
+        next.reserve(boxesPerFrame);
+        isLarge.reserve(boxesPerFrame);
+        waiting.reserve(boxesPerFrame);
+        for (auto& w : tileWaiters) w.reserve(boxesPerFrame);
+        ready.reserve(boxesPerFrame);
+        arrived.reserve(boxesPerFrame);
+        readyScratch.reserve(boxesPerFrame);
+        large.reserve(boxesPerFrame);
+        fresh.reserve(boxesPerFrame);
+        report.reserve(boxesPerFrame);
+        degenerate.reserve(boxesPerFrame);
+        merged.reserve(boxesPerFrame);
+        lastCapacity = capacity();
+    }
+
+    void beginFrame() {
+        ++frame;
+        boxes.clear();
+        key.clear();
+        state.clear();
+        next.clear();
+        isLarge.clear();
+        waiting.clear();
+        for (auto& w : tileWaiters) w.clear();
+        ready.clear();
+        arrived.clear();
+        large.clear();
+        fresh.clear();
+        report.clear();
+        degenerate.clear();
+        std::fill(head.begin(), head.end(), -1);
+        std::fill(tileDone.begin(), tileDone.end(), 0);
+        incomplete = tilesX * tilesY;
+        frameMs = 0;
+        undecided = 0;
+    }
+
+    void addBatch(const BBox* batch, size_t n) {
+        frameMs += timeMs([&] {
+            for (size_t k = 0; k < n; ++k) {
+                const BBox& b = batch[k];
+                int idx = (int)boxes.size();
+                boxes.push_back(b);
+                key.push_back(descendingKey(b.score));
+                next.push_back(-1);
+                waiting.push_back(0);
+                float w = b.x2 - b.x1, h = b.y2 - b.y1;
+                // ֵǸʱ߲ΪĿضҲƱĿ´ decide ʱ
+                if (thr >= 0.0f && !(w > 0 && h > 0)) {
+                    state.push_back(KEPT);
+                    isLarge.push_back(0);
+                    degenerate.push_back(idx);
+                    continue;
+                }
+                state.push_back(PENDING);
+                ++undecided;
+                bool oversized = !(w <= maxSize && h <= maxSize);
+                assert((!oversized || incomplete == tilesX * tilesY) && "κ֮ǰʹ");
+                // ֵΪʱཻĿҲụƣп򶼰֡ʱͳһȷ
+                if (!(thr >= 0.0f) || oversized) {
+                    isLarge.push_back(1);
+                    large.push_back(idx);
+                    if (incomplete == 0) arrived.push_back(idx);
+                    continue;
+                }
+                isLarge.push_back(0);
+                size_t c = (size_t)cellY((b.y1 + b.y2) / 2) * gx + cellX((b.x1 + b.x2) / 2);
+                int* link = &head[c];
+                while (*link >= 0 && before(*link, idx)) link = &next[*link];
+                next[idx] = *link;
+                *link = idx;
+                waitForTiles(idx);
+            }
+        });
+    }
+
+    // ɣϴεȷĿ򣨰򣻻´εʱã
+    const std::vector<Detection>& completeTile(int tx, int ty) {
+        frameMs += timeMs([&] {
+            if (tx >= 0 && tx < tilesX && ty >= 0 && ty < tilesY) finishTile((size_t)ty * tilesX + tx);
+            decide();
+        });
+        return flush();
+    }
+
+    // ֡ȫΪɣʣµĿȷ¼֡ʱ
+    const std::vector<Detection>& endFrame() {
+        frameMs += timeMs([&] {
+            for (size_t t = 0; t < tileDone.size(); ++t) finishTile(t);
+            decide();
+        });
+        latency[latencyCount % LATENCY_HISTORY] = frameMs;
+        ++latencyCount;
+        size_t cap = capacity();
+        if (cap > lastCapacity) ++growths;
+        lastCapacity = cap;
+        return flush();
+    }
+
+    // ڵ飬 completeTile Լһ
+    void tileOf(const BBox& b, int& tx, int& ty) const {
+        tx = clampIndex((b.x1 + b.x2) / 2 * (tilesX / width), tilesX);
+        ty = clampIndex((b.y1 + b.y2) / 2 * (tilesY / height), tilesY);
+    }
+
+    size_t pendingCount() const { return undecided; }
+
+    // ֡reserve 㹻ʱӦΪ 0
+    int bufferGrowths() const { return growths; }
+
+    //  LATENCY_HISTORY ֡ÿ֡ʱķλ룩
+    double latencyQuantile(double q) {
+        size_t n = std::min(latencyCount, LATENCY_HISTORY);
+        if (n == 0) return 0;
+        latencyScratch.assign(latency.begin(), latency.begin() + n);
+        size_t k = std::min(n - 1, (size_t)std::ceil(q * n) - (q > 0 ? 1 : 0));
+        std::nth_element(latencyScratch.begin(), latencyScratch.begin() + k, latencyScratch.end());
+        return latencyScratch[k];
+    }
+
+private:
+    enum : uint8_t { PENDING, KEPT, SUPPRESSED };
+    static constexpr size_t LATENCY_HISTORY = 4096;
+
+    static int clampIndex(float v, int n) {
+        return v >= 0 ? std::min(n - 1, (int)std::min(v, (float)n)) : 0;
+    }
+    int cellX(float x) const { return clampIndex(x * (gx / width), gx); }
+    int cellY(float y) const { return clampIndex(y * (gy / height), gy); }
+
+    // ְͬ˳
+    bool before(int a, int b) const { return key[a] != key[b] ? key[a] < key[b] : a < b; }
+
+    size_t capacity() const {
+        size_t c = boxes.capacity() + key.capacity() + state.capacity() + next.capacity() + isLarge.capacity() +
+                   waiting.capacity() + ready.capacity() + arrived.capacity() + readyScratch.capacity() +
+                   large.capacity() + fresh.capacity() + report.capacity() + degenerate.capacity() +
+                   merged.capacity();
+        for (const auto& w : tileWaiters) c += w.capacity();
+        return c;
+    }
+
+    // Сֻı߲ maxBoxSize / 2 Ŀཻ maxBoxSize / 16 룻
+    // Щڵ鶼ɺž
+    void waitForTiles(int b) {
+        const BBox& box = boxes[b];
+        float m = maxSize / 2 + maxSize / 16;
+        int tx0 = clampIndex((box.x1 - m) * (tilesX / width), tilesX);
+        int tx1 = clampIndex((box.x2 + m) * (tilesX / width), tilesX);
+        int ty0 = clampIndex((box.y1 - m) * (tilesY / height), tilesY);
+        int ty1 = clampIndex((box.y2 + m) * (tilesY / height), tilesY);
+        for (int ty = ty0; ty <= ty1; ++ty) {
+            for (int tx = tx0; tx <= tx1; ++tx) {
+                size_t t = (size_t)ty * tilesX + tx;
+                if (tileDone[t]) continue;
+                ++waiting[b];
+                tileWaiters[t].push_back(b);
+            }
+        }
+        if (waiting[b] == 0) arrived.push_back(b);
+    }
+
+    void finishTile(size_t t) {
+        if (tileDone[t]) return;
+        tileDone[t] = 1;
+        for (int b : tileWaiters[t])
+            if (--waiting[b] == 0) arrived.push_back(b);
+        tileWaiters[t].clear();
+        if (--incomplete == 0) {
+            for (int b : large) arrived.push_back(b);
+        }
+    }
+
+    const std::vector<Detection>& flush() {
+        report.swap(fresh);
+        fresh.clear();
+        return report;
+    }
+
+    //  b ཻĸ߷ֿб b ƣδȷ b Ҳݲȷ
+    uint8_t classify(int b, int c, bool& blocked) const {
+        if (c == b || state[c] == SUPPRESSED || !before(c, b)) return PENDING;
+        if (!(computeIoU(boxes[c], boxes[b]) > thr)) return PENDING;
+        if (state[c] == KEPT) return SUPPRESSED;
+        blocked = true;
+        return PENDING;
+    }
+
+    // b ѾཻĿʹ
+    uint8_t decideOne(int b) {
+        bool blocked = false;
+        if (isLarge[b]) {
+            for (int c = 0; c < (int)boxes.size(); ++c)
+                if (classify(b, c, blocked) == SUPPRESSED) return SUPPRESSED;
+            return blocked ? PENDING : KEPT;
+        }
+        const BBox& box = boxes[b];
+        float m = maxSize / 2 + maxSize / 16;
+        for (int c : large)
+            if (classify(b, c, blocked) == SUPPRESSED) return SUPPRESSED;
+        int cx0 = cellX(box.x1 - m), cx1 = cellX(box.x2 + m);
+        int cy0 = cellY(box.y1 - m), cy1 = cellY(box.y2 + m);
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                int* link = &head[(size_t)cy * gx + cx];
+                while (*link >= 0) {
+                    int c = *link;
+                    if (state[c] == SUPPRESSED) {
+                        *link = next[c];
+                        continue;
+                    }
+                    if (!before(c, b)) break;   // ǸͷֵĿ
+                    if (classify(b, c, blocked) == SUPPRESSED) return SUPPRESSED;
+                    link = &next[c];
+                }
+            }
+        }
+        return blocked ? PENDING : KEPT;
+    }
+
+    // ¾Ŀ򰴷ٰɨ裺߷ֵĿͬһȷ
+    // ȷȫȷδȷĸ߷ֿסڱһ
+    void decide() {
+        auto order = [this](int a, int b) { return before(a, b); };
+        if (!arrived.empty()) {
+            std::sort(arrived.begin(), arrived.end(), order);
+            readyScratch.resize(ready.size() + arrived.size());
+            std::merge(ready.begin(), ready.end(), arrived.begin(), arrived.end(), readyScratch.begin(), order);
+            ready.swap(readyScratch);
+            arrived.clear();
+        }
+        size_t w = 0;
+        for (int b : ready) {
+            uint8_t s = decideOne(b);
+            state[b] = s;
+            if (s == PENDING) {
+                ready[w++] = b;
+                continue;
+            }
+            --undecided;
+            if (s == KEPT) fresh.push_back({boxes[b], frame, 0, b});
+        }
+        ready.resize(w);
+        if (degenerate.empty()) return;
+
+        // ˻뱾ȷĿ򰴷鲢
+        std::sort(degenerate.begin(), degenerate.end(), order);
+        merged.clear();
+        size_t i = 0;
+        for (int d : degenerate) {
+            while (i < fresh.size() && before(fresh[i].index, d)) merged.push_back(fresh[i++]);
+            merged.push_back({boxes[d], frame, 0, d});
+        }
+        merged.insert(merged.end(), fresh.begin() + i, fresh.end());
+        fresh.swap(merged);
+        degenerate.clear();
+    }
+
+    float width, height;
+    int tilesX, tilesY;
+    float maxSize, thr;
+    int gx, gy;
+    int frame;
+    int incomplete;
+    double frameMs;
+    size_t undecided;                 // δȷĿ
+
+    std::vector<BBox> boxes;          // ֡Ŀ±꼴˳
+    std::vector<uint32_t> key;
+    std::vector<uint8_t> state;
+    std::vector<int> next;            // 
+    std::vector<uint8_t> isLarge;
+    std::vector<int> head;
+    std::vector<int> waiting;         // Сཻδɵĸ
+    std::vector<std::vector<int>> tileWaiters;   // ϵǼǵġڵɵĿ
+    std::vector<int> ready;           // ѾδȷĿ򣬰
+    std::vector<int> arrived;         // ϴ decide ֮¾Ŀ
+    std::vector<int> readyScratch;
+    std::vector<int> large;
+    std::vector<uint8_t> tileDone;
+    std::vector<Detection> fresh, report;   // Detection::index Ϊ֡˳cls ʹ
+    std::vector<int> degenerate;            // δ˻
+    std::vector<Detection> merged;
+
+    std::vector<double> latency, latencyScratch;
+    size_t latencyCount;
+    int growths;
+    size_t lastCapacity;
 };
 
+
+// ͬһ϶Աȱ NMS NMS  SIMD λ NMSһʱ [MISMATCH]
+void compareNMS(const std::vector<BBox>& sorted, float iou_thresh) {
+    std::vector<BBox> brute, grid, simd;
+    SimdLevel level = detectSimd();
+    double tb = timeMs([&] { brute = nms(sorted, iou_thresh); });
+    double tg = timeMs([&] { grid = nmsGrid(sorted, iou_thresh); });
+    double ts = timeMs([&] { simd = nmsSIMD(sorted, iou_thresh, level); });
+    bool same = sameBoxes(brute, grid) && sameBoxes(brute, simd);
+    // ָƾֻһԼ
+    if (level != SimdLevel::Scalar) same = same && sameBoxes(brute, nmsSIMD(sorted, iou_thresh, SimdLevel::Scalar));
+    if (level == SimdLevel::AVX512) same = same && sameBoxes(brute, nmsSIMD(sorted, iou_thresh, SimdLevel::AVX2));
+    if (sorted.size() <= 10000) {
+        BoxBatch batch(sorted);
+        same = same && greedyFromMatrix(suppressionMatrix(batch, iou_thresh, level), batch.n) ==
+                       nmsBitmask(batch, iou_thresh, level);
+    }
+    std::cout << "    " << std::setw(12) << "NMS only" << ": brute " << std::setw(8) << tb
+              << " ms, grid " << std::setw(8) << tg << " ms (" << std::setw(6) << tb / std::max(tg, 1e-3)
+              << "x), " << simdName(level) << " " << std::setw(8) << ts << " ms (" << std::setw(6)
+              << tb / std::max(ts, 1e-3) << "x), kept " << grid.size()
+              << (same ? "" : "  [MISMATCH]") << "\n";
+}
+
 void runExperiment(const std::vector<TestCase>& test_cases,
                    const std::vector<Algorithm>& algorithms,
                    const std::vector<int>& sizes) {
@@ -239,6 +1374,7 @@ void runExperiment(const std::vector<TestCase>& test_cases,
         for (const auto& tc : test_cases) {
             std::cout << "  Distribution: " << tc.name << "\n";
             auto boxes = tc.generator(n);
+            std::vector<BBox> sorted;
 
             for (const auto& algo : algorithms) {
                 auto boxes_copy = boxes;
@@ -253,24 +1389,626 @@ void runExperiment(const std::vector<TestCase>& test_cases,
 
                 std::cout << "    " << std::setw(12) << algo.name << ": "
                           << std::setw(8) << time_ms << " ms\n";
+                if (&algo == &algorithms.front()) sorted = boxes_copy;
             }
+            compareNMS(sorted, iou_thresh);
             std::cout << "\n";
         }
     }
 }
 
+// ģֻȽ NMS ðݵ O(n^2) ڴ˹ģã std::sort Ԥ
+void runNMSScaling(const std::vector<TestCase>& test_cases, const std::vector<int>& sizes) {
+    const float iou_thresh = 0.5f;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "=== Grid NMS Scaling ===\n\n";
+    for (int n : sizes) {
+        std::cout << ">>> Testing with " << n << " bounding boxes:\n";
+        for (const auto& tc : test_cases) {
+            std::cout << "  Distribution: " << tc.name << "\n";
+            auto boxes = tc.generator(n);
+            std::sort(boxes.begin(), boxes.end(), [](const BBox& a, const BBox& b) { return a.score > b.score; });
+            compareNMS(boxes, iou_thresh);
+        }
+        std::cout << "\n";
+    }
+}
+
+// ͼ NMSδе nms Աȣ topK Soft-NMS
+void runBatchedExperiment(int images, int classes, int perClass) {
+    std::vector<BBox> boxes;
+    std::vector<Segment> segments;
+    for (int i = 0; i < images; ++i) {
+        for (int c = 0; c < classes; ++c) {
+            std::vector<BBox> part = generateRandomBoxes(perClass, (unsigned)(i * classes + c + 1));
+            segments.push_back({i, c, boxes.size(), boxes.size() + part.size()});
+            boxes.insert(boxes.end(), part.begin(), part.end());
+        }
+    }
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "=== Batched NMS: " << images << " images x " << classes << " classes x "
+              << perClass << " boxes ===\n";
+
+    // лߣÿΰȶ nms¼±
+    std::vector<std::vector<int>> ref(images);
+    double ts = timeMs([&] {
+        for (const Segment& seg : segments) {
+            std::vector<int> idx;
+            for (size_t k = seg.begin; k < seg.end; ++k) idx.push_back((int)k);
+            std::stable_sort(idx.begin(), idx.end(), [&](int a, int b) { return boxes[a].score > boxes[b].score; });
+            std::vector<BBox> sorted;
+            for (int k : idx) sorted.push_back(boxes[k]);
+            std::vector<BBox> kept = nms(sorted, 0.5f);
+            for (size_t k = 0, t = 0; k < sorted.size() && t < kept.size(); ++k)
+                if (std::memcmp(&sorted[k], &kept[t], sizeof(BBox)) == 0) { ref[seg.image].push_back(idx[k]); ++t; }
+        }
+    });
+    std::cout << "    " << std::setw(20) << "Sequential nms" << ": " << std::setw(8) << ts << " ms\n";
+
+    WorkStealingPool pool;
+    BatchedNMS engine(pool);
+    DetectionBuffer out;
+    NMSParams params;
+    engine.run(boxes, segments, params, out);   // Ԥȣøﵽ̬
+    double tb = timeMs([&] { engine.run(boxes, segments, params, out); });
+    bool same = true;
+    for (int i = 0; i < images; ++i) {
+        std::vector<int> got;
+        for (size_t k = out.imageStart[i]; k < out.imageStart[i + 1]; ++k) got.push_back(out.dets[k].index);
+        std::sort(got.begin(), got.end());
+        std::sort(ref[i].begin(), ref[i].end());
+        same = same && got == ref[i];
+    }
+    std::cout << "    " << std::setw(20) << "Batched hard" << ": " << std::setw(8) << tb << " ms ("
+              << pool.size() << " threads, " << out.count << " kept)" << (same ? "" : "  [MISMATCH]") << "\n";
+
+    const char* names[] = {"Hard top100/cap100", "SoftLinear top100", "SoftGauss top100"};
+    NMSMode modes[] = {NMSMode::Hard, NMSMode::SoftLinear, NMSMode::SoftGaussian};
+    for (int m = 0; m < 3; ++m) {
+        NMSParams p;
+        p.mode = modes[m];
+        p.topK = 100;
+        p.maxDetections = 100;
+        out.reserve(images, p.maxDetections);
+        engine.run(boxes, segments, p, out);
+        double t = timeMs([&] { engine.run(boxes, segments, p, out); });
+        bool ordered = true;
+        for (int i = 0; i < images; ++i) {
+            ordered = ordered && out.imageStart[i + 1] - out.imageStart[i] <= 100;
+            for (size_t k = out.imageStart[i] + 1; k < out.imageStart[i + 1]; ++k)
+                ordered = ordered && !scoreBefore(out.dets[k], out.dets[k - 1]);
+        }
+        std::cout << "    " << std::setw(20) << names[m] << ": " << std::setw(8) << t << " ms ("
+                  << out.count << " kept)" << (ordered ? "" : "  [MISMATCH]") << "\n";
+    }
+    std::cout << "\n";
+}
+
+// ʽ NMSģ 1920x10804x3 ֿƵ֡˳벢ɣ
+// ֡ȶ nms Աȣͳǰıÿ֡ӳٷλͻ
+// ְͬ˳ StreamingNMS ÿĴͬ
+bool detectionOrder(const Detection& a, const Detection& b) {
+    uint32_t ka = descendingKey(a.box.score), kb = descendingKey(b.box.score);
+    return ka != kb ? ka < kb : a.index < b.index;
+}
+
+void runStreamingExperiment(int frames, int objectsPerFrame, float iou_thresh = 0.5f) {
+    const float W = 1920, H = 1080, MAX_BOX = 160;
+    const int TX = 4, TY = 3;
+    StreamingNMS stream(W, H, TX, TY, MAX_BOX, iou_thresh);
+    stream.reserve((size_t)objectsPerFrame * 6 + 8);
+
+    std::vector<std::vector<BBox>> tiles(TX * TY);
+    std::vector<BBox> all, ref, got;
+    std::vector<Detection> dets;
+    std::vector<double> batchMs;
+    size_t early = 0, kept = 0, total = 0;
+    bool same = true;
+    for (int f = 0; f < frames; ++f) {
+        // ÿĿ 1~6 ظĴ
+        std::mt19937 gen((unsigned)f + 1);
+        std::uniform_real_distribution<float> cx(0, W), cy(0, H), side(20, 150), jitter(-8, 8), score(0, 1);
+        for (auto& t : tiles) t.clear();
+        std::vector<BBox> largeBoxes;
+        for (int k = 0; k < 2; ++k) {
+            float x = cx(gen), y = cy(gen);
+            largeBoxes.emplace_back(x - 200, y - 150, x + 200, y + 150, score(gen));
+        }
+        // ԼΪ 0 ˻
+        for (int k = 0; k < 3; ++k) {
+            float x = cx(gen), y = cy(gen);
+            BBox b(x, y, x + (k == 0 ? 0 : 30), y + (k == 0 ? 30 : 0), score(gen));
+            int tx, ty;
+            stream.tileOf(b, tx, ty);
+            tiles[ty * TX + tx].push_back(b);
+        }
+        for (int o = 0; o < objectsPerFrame; ++o) {
+            float x = cx(gen), y = cy(gen), w = side(gen), h = side(gen);
+            int copies = 1 + (int)(gen() % 6);
+            for (int c = 0; c < copies; ++c) {
+                float dx = jitter(gen), dy = jitter(gen);
+                BBox b(x - w / 2 + dx, y - h / 2 + dy, x + w / 2 + dx, y + h / 2 + dy, score(gen));
+                int tx, ty;
+                stream.tileOf(b, tx, ty);
+                tiles[ty * TX + tx].push_back(b);
+            }
+        }
+
+        all.clear();
+        dets.clear();
+        stream.beginFrame();
+        stream.addBatch(largeBoxes.data(), largeBoxes.size());
+        all.insert(all.end(), largeBoxes.begin(), largeBoxes.end());
+        for (int ty = 0; ty < TY; ++ty) {
+            for (int tx = 0; tx < TX; ++tx) {
+                const std::vector<BBox>& t = tiles[ty * TX + tx];
+                stream.addBatch(t.data(), t.size());
+                all.insert(all.end(), t.begin(), t.end());
+                const std::vector<Detection>& out = stream.completeTile(tx, ty);
+                if (ty * TX + tx < TX * TY - 1) early += out.size();
+                same = same && std::is_sorted(out.begin(), out.end(), detectionOrder);
+                dets.insert(dets.end(), out.begin(), out.end());
+            }
+        }
+        const std::vector<Detection>& rest = stream.endFrame();
+        same = same && std::is_sorted(rest.begin(), rest.end(), detectionOrder);
+        dets.insert(dets.end(), rest.begin(), rest.end());
+        kept += dets.size();
+        total += all.size();
+
+        // ֡ߣȶ nmsְͬ˳
+        batchMs.push_back(timeMs([&] {
+            ref = all;
+            radixSortByScore(ref);
+            ref = nmsGrid(ref, iou_thresh);
+        }));
+        std::sort(dets.begin(), dets.end(), detectionOrder);
+        got.clear();
+        for (const Detection& d : dets) got.push_back(d.box);
+        same = same && sameBoxes(got, ref) && stream.pendingCount() == 0;
+    }
+
+    std::sort(batchMs.begin(), batchMs.end());
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "=== Streaming NMS: " << frames << " frames, " << TX << "x" << TY << " tiles, ~"
+              << total / std::max(1, frames) << " boxes/frame, IoU > " << iou_thresh << " ===\n";
+    std::cout << "    kept " << kept << ", finalized before the last tile completes "
+              << std::setprecision(1) << 100.0 * early / std::max<size_t>(1, kept) << "%"
+              << (same ? "" : "  [MISMATCH]") << "\n";
+    std::cout << std::setprecision(3);
+    std::cout << "    per-frame latency: p50 " << stream.latencyQuantile(0.5) << " ms, p99 "
+              << stream.latencyQuantile(0.99) << " ms, max " << stream.latencyQuantile(1.0)
+              << " ms (whole-frame sort + grid NMS p50 " << batchMs[batchMs.size() / 2] << " ms)\n";
+    std::cout << "    frames with buffer growth: " << stream.bufferGrowths() << "\n\n";
+}
+
+// ģԱȣ NMSȶӦ std::stable_sort λһ£
+// ȽϷУTopK Ƚǰ k 
+void runSortScaling(const std::vector<TestCase>& test_cases, const std::vector<Algorithm>& algorithms,
+                    const std::vector<int>& sizes) {
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "=== Sort Scaling (sort only) ===\n\n";
+    for (int n : sizes) {
+        std::cout << ">>> Sorting " << n << " bounding boxes:\n";
+        for (const auto& tc : test_cases) {
+            std::cout << "  Distribution: " << tc.name << "\n";
+            auto boxes = tc.generator(n);
+            auto ref = boxes;
+            double tr = timeMs([&] {
+                std::stable_sort(ref.begin(), ref.end(), [](const BBox& a, const BBox& b) { return a.score > b.score; });
+            });
+            std::cout << "    " << std::setw(12) << "stable_sort" << ": " << std::setw(8) << tr << " ms\n";
+            for (const auto& algo : algorithms) {
+                auto copy = boxes;
+                double t = timeMs([&] { algo.sort_func(copy); });
+                bool ok = copy.size() <= ref.size();
+                for (size_t i = 0; ok && i < copy.size(); ++i) ok = copy[i].score == ref[i].score;
+                bool stable = copy.size() == ref.size() && sameBoxes(copy, ref);
+                std::cout << "    " << std::setw(12) << algo.name << ": " << std::setw(8) << t << " ms"
+                          << (stable ? " (stable)" : "") << (ok ? "" : "  [MISMATCH]") << "\n";
+            }
+        }
+        std::cout << "\n";
+    }
+}
+
+// ==============================
+// ׼Կ
+// ==============================
+
+// ̶ӡԤȡظȡͳɰˡȡӲд JSON / CSV
+// ɶԱνҳܻˡ NMS ׶ηֱʱ
+struct BenchConfig {
+    std::vector<int> sizes;
+    int warmup;
+    int trials;
+    int cpu;                 // 󶨵ĺˣ-1 ʾ
+    std::string nmsEngine;   // grid / simd / brute
+    std::string json, csv;
+
+    BenchConfig() : sizes({1000, 100000, 1000000}), warmup(1), trials(7), cpu(0), nmsEngine("grid") {}
+};
+
+struct BenchStats {
+    double median, p95, mad, min;
+};
+
+struct BenchRecord {
+    std::string distribution, algorithm, phase;
+    int n;
+    int trials;
+    BenchStats ms;
+    long long counters[3];   // cycles / cache misses / branch misses λ-1 ʾ
+};
+
+const char* COUNTER_NAMES[3] = {"cycles", "cache_misses", "branch_misses"};
+
+BenchStats summarize(std::vector<double> xs) {
+    BenchStats s = {0, 0, 0, 0};
+    if (xs.empty()) return s;
+    std::sort(xs.begin(), xs.end());
+    auto median = [](const std::vector<double>& v) {
+        size_t m = v.size() / 2;
+        return v.size() % 2 ? v[m] : (v[m - 1] + v[m]) / 2;
+    };
+    s.median = median(xs);
+    s.p95 = xs[std::min(xs.size() - 1, (size_t)std::ceil(0.95 * xs.size()) - 1)];
+    s.min = xs.front();
+    std::vector<double> dev;
+    for (double x : xs) dev.push_back(std::fabs(x - s.median));
+    std::sort(dev.begin(), dev.end());
+    s.mad = median(dev);
+    return s;
+}
+
+// ˣpin() ѵǰָ̰߳ˣǨƺƵʲ
+// unpin() ָʱ׺롣֮󴴽̻̳߳еʱ룬
+// Զ̵߳Ҫ unpin()߳ȫһϡ Linux ƽ̨
+class CoreBinding {
+public:
+    explicit CoreBinding(int core) : cpu(core), saved(false) {
+#if defined(__linux__)
+        CPU_ZERO(&original);
+        saved = sched_getaffinity(0, sizeof(original), &original) == 0;
+#endif
+    }
+
+    bool pin() {
+#if defined(__linux__)
+        if (cpu < 0) return false;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+        return false;
+#endif
+    }
+
+    void unpin() {
+#if defined(__linux__)
+        if (saved) sched_setaffinity(0, sizeof(original), &original);
+#endif
+    }
+
+private:
+    int cpu;
+    bool saved;
+#if defined(__linux__)
+    cpu_set_t original;
+#endif
+};
+
+// perf_event_open Ӳֻͳû̬ʱڼ䴴̣߳
+// Ȩ޻ Linux ʱ available() Ϊ falseʱں˻ʱã
+//  enabled / running ʱŴһҲûֵļΪ -1
+class PerfCounters {
+public:
+    PerfCounters() {
+        for (int i = 0; i < 3; ++i) {
+            fd[i] = -1;
+            base[i].ok = false;
+        }
+#if defined(__linux__)
+        const unsigned long long events[3] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES,
+                                              PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < 3; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = events[i];
+            attr.disabled = i == 0;
+            attr.inherit = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fd[0], 0);
+            if (i == 0 && fd[0] < 0) break;
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (int i = 0; i < 3; ++i)
+            if (fd[i] >= 0) close(fd[i]);
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return fd[0] >= 0; }
+
+    // RESET  enabled / running ʱ䣬Լ㣬stop ʱȡֵ
+    void start() {
+#if defined(__linux__)
+        if (!available()) return;
+        for (int i = 0; i < 3; ++i) readRaw(i, base[i]);
+        ioctl(fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    void stop(long long out[3]) {
+        for (int i = 0; i < 3; ++i) out[i] = -1;
+#if defined(__linux__)
+        if (!available()) return;
+        ioctl(fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        for (int i = 0; i < 3; ++i) {
+            Reading r;
+            if (!readRaw(i, r) || !base[i].ok) continue;
+            unsigned long long value = r.value - base[i].value;
+            unsigned long long enabled = r.enabled - base[i].enabled, running = r.running - base[i].running;
+            if (running == 0) continue;
+            out[i] = running < enabled ? (long long)((double)value * enabled / running) : (long long)value;
+        }
+#endif
+    }
+
+private:
+    struct Reading {
+        unsigned long long value, enabled, running;
+        bool ok;
+    };
+
+    int fd[3];
+    Reading base[3];
+
+    bool readRaw(int i, Reading& r) {
+        r.ok = false;
+#if defined(__linux__)
+        unsigned long long v[3];
+        if (fd[i] >= 0 && read(fd[i], v, sizeof(v)) == (ssize_t)sizeof(v)) {
+            r.value = v[0];
+            r.enabled = v[1];
+            r.running = v[2];
+            r.ok = true;
+        }
+#else
+        (void)i;
+#endif
+        return r.ok;
+    }
+};
+
+// Ԥ warmup Σظ trials Σprepare ʱ縴룩body ʱͳƼ
+template <typename Prepare, typename Body>
+BenchRecord measure(const BenchConfig& cfg, PerfCounters& perf, Prepare prepare, Body body) {
+    BenchRecord r;
+    r.trials = cfg.trials;
+    std::vector<double> times;
+    std::vector<long long> samples[3];
+    for (int t = 0; t < cfg.warmup + cfg.trials; ++t) {
+        prepare();
+        long long c[3];
+        perf.start();
+        double ms = timeMs(body);
+        perf.stop(c);
+        if (t < cfg.warmup) continue;
+        times.push_back(ms);
+        for (int i = 0; i < 3; ++i) samples[i].push_back(c[i]);
+    }
+    r.ms = summarize(times);
+    for (int i = 0; i < 3; ++i) {
+        std::sort(samples[i].begin(), samples[i].end());
+        r.counters[i] = samples[i].empty() || samples[i][0] < 0 ? -1 : samples[i][samples[i].size() / 2];
+    }
+    return r;
+}
+
+void writeJSON(const std::vector<BenchRecord>& records, const BenchConfig& cfg, std::ostream& os) {
+    os << "{\"seed\": 42, \"warmup\": " << cfg.warmup << ", \"trials\": " << cfg.trials
+       << ", \"cpu\": " << cfg.cpu << ", \"nms\": \"" << cfg.nmsEngine << "\",\n\"results\": [\n";
+    os << std::setprecision(6);
+    for (size_t i = 0; i < records.size(); ++i) {
+        const BenchRecord& r = records[i];
+        os << "{\"distribution\": \"" << r.distribution << "\", \"algorithm\": \"" << r.algorithm
+           << "\", \"phase\": \"" << r.phase << "\", \"n\": " << r.n << ", \"trials\": " << r.trials
+           << ", \"median_ms\": " << r.ms.median << ", \"p95_ms\": " << r.ms.p95 << ", \"mad_ms\": " << r.ms.mad
+           << ", \"min_ms\": " << r.ms.min;
+        for (int c = 0; c < 3; ++c) os << ", \"" << COUNTER_NAMES[c] << "\": " << r.counters[c];
+        os << "}" << (i + 1 < records.size() ? "," : "") << "\n";
+    }
+    os << "]}\n";
+}
+
+void writeCSV(const std::vector<BenchRecord>& records, std::ostream& os) {
+    os << "distribution,algorithm,phase,n,trials,median_ms,p95_ms,mad_ms,min_ms,cycles,cache_misses,branch_misses\n";
+    os << std::setprecision(6);
+    for (const BenchRecord& r : records) {
+        os << r.distribution << "," << r.algorithm << "," << r.phase << "," << r.n << "," << r.trials << ","
+           << r.ms.median << "," << r.ms.p95 << "," << r.ms.mad << "," << r.ms.min;
+        for (int c = 0; c < 3; ++c) os << "," << r.counters[c];
+        os << "\n";
+    }
+}
+
+// ֻȡд JSONÿռһУȡֶ
+static std::string jsonField(const std::string& line, const std::string& key) {
+    std::string pat = "\"" + key + "\": ";
+    size_t p = line.find(pat);
+    if (p == std::string::npos) return "";
+    p += pat.size();
+    if (p < line.size() && line[p] == '"') {
+        size_t q = line.find('"', p + 1);
+        return q == std::string::npos ? "" : line.substr(p + 1, q - p - 1);
+    }
+    size_t q = line.find_first_of(",}", p);
+    return line.substr(p, q == std::string::npos ? std::string::npos : q - p);
+}
+
+bool readJSON(const char* path, std::vector<BenchRecord>& records) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.find("\"algorithm\"") == std::string::npos) continue;
+        BenchRecord r;
+        r.distribution = jsonField(line, "distribution");
+        r.algorithm = jsonField(line, "algorithm");
+        r.phase = jsonField(line, "phase");
+        r.n = std::atoi(jsonField(line, "n").c_str());
+        r.trials = std::atoi(jsonField(line, "trials").c_str());
+        r.ms.median = std::atof(jsonField(line, "median_ms").c_str());
+        r.ms.p95 = std::atof(jsonField(line, "p95_ms").c_str());
+        r.ms.mad = std::atof(jsonField(line, "mad_ms").c_str());
+        r.ms.min = std::atof(jsonField(line, "min_ms").c_str());
+        for (int c = 0; c < 3; ++c) r.counters[c] = std::atoll(jsonField(line, COUNTER_NAMES[c]).c_str());
+        records.push_back(r);
+    }
+    return true;
+}
+
+// Աνλ thresholdPctҲֵ MAD ϴߵ 3 Ϊˡ
+// лʱ 1ڽűʹ
+int compareBench(const char* basePath, const char* newPath, double thresholdPct) {
+    std::vector<BenchRecord> base, cur;
+    if (!readJSON(basePath, base) || !readJSON(newPath, cur)) {
+        std::cerr << "cannot read result files\n";
+        return 2;
+    }
+    int regressions = 0;
+    std::cout << std::fixed << std::setprecision(3);
+    for (const BenchRecord& r : cur) {
+        const BenchRecord* b = nullptr;
+        for (const BenchRecord& x : base)
+            if (x.distribution == r.distribution && x.algorithm == r.algorithm && x.phase == r.phase && x.n == r.n)
+                b = &x;
+        if (!b) continue;
+        double delta = b->ms.median > 0 ? (r.ms.median - b->ms.median) / b->ms.median * 100 : 0;
+        double noise = 3 * std::max(b->ms.mad, r.ms.mad);
+        const char* verdict = "ok";
+        if (delta > thresholdPct && r.ms.median - b->ms.median > noise) {
+            verdict = "REGRESSION";
+            ++regressions;
+        } else if (-delta > thresholdPct && b->ms.median - r.ms.median > noise) {
+            verdict = "improved";
+        }
+        std::cout << std::setw(10) << r.distribution << " " << std::setw(12) << r.algorithm << " "
+                  << std::setw(5) << r.phase << " n=" << std::setw(8) << r.n << ": " << std::setw(10)
+                  << b->ms.median << " -> " << std::setw(10) << r.ms.median << " ms (" << std::showpos
+                  << std::setprecision(1) << delta << std::noshowpos << std::setprecision(3) << "%) "
+                  << verdict << "\n";
+    }
+    std::cout << regressions << " regression(s)\n";
+    return regressions > 0 ? 1 : 0;
+}
+
+int runBench(const BenchConfig& cfg, const std::vector<TestCase>& test_cases,
+             const std::vector<Algorithm>& algorithms) {
+    CoreBinding binding(cfg.cpu);
+    bool pinned = binding.pin();
+    PerfCounters perf;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "=== NMS Benchmark (seed 42, warmup " << cfg.warmup << ", trials " << cfg.trials
+              << ", core " << (pinned ? std::to_string(cfg.cpu) + " except parallel sorts" : std::string("unpinned"))
+              << ", perf counters "
+              << (perf.available() ? "on" : "off") << ") ===\n";
+
+    auto desc = [](const BBox& a, const BBox& b) { return a.score > b.score; };
+    std::vector<BenchRecord> records;
+    for (int n : cfg.sizes) {
+        for (const auto& tc : test_cases) {
+            const std::vector<BBox> input = tc.generator(n);
+            std::vector<BBox> work;
+            // ׶ΣO(n^2) ðֻСģ²
+            for (const auto& algo : algorithms) {
+                if (algo.name == "BubbleSort" && n > 20000) continue;
+                if (algo.parallel) binding.unpin();
+                else binding.pin();
+                BenchRecord r = measure(cfg, perf, [&] { work = input; }, [&] { algo.sort_func(work); });
+                r.distribution = tc.name;
+                r.algorithm = algo.name;
+                r.phase = "sort";
+                r.n = n;
+                records.push_back(r);
+            }
+            // NMS ׶Σȶͬһϼʱ
+            std::vector<BBox> sorted = input;
+            std::stable_sort(sorted.begin(), sorted.end(), desc);
+            std::vector<BBox> kept;
+            binding.pin();
+            BenchRecord r = measure(cfg, perf, [] {}, [&] {
+                if (cfg.nmsEngine == "brute") kept = nms(sorted, 0.5f);
+                else if (cfg.nmsEngine == "simd") kept = nmsSIMD(sorted, 0.5f);
+                else kept = nmsGrid(sorted, 0.5f);
+            });
+            r.distribution = tc.name;
+            r.algorithm = cfg.nmsEngine;
+            r.phase = "nms";
+            r.n = n;
+            records.push_back(r);
+        }
+    }
+
+    std::cout << std::setw(10) << "dist" << " " << std::setw(12) << "algorithm" << " " << std::setw(5) << "phase"
+              << " " << std::setw(8) << "n" << std::setw(11) << "median" << std::setw(11) << "p95"
+              << std::setw(9) << "MAD" << std::setw(15) << "cycles" << std::setw(12) << "cache-miss"
+              << std::setw(12) << "br-miss" << "\n";
+    for (const BenchRecord& r : records) {
+        std::cout << std::setw(10) << r.distribution << " " << std::setw(12) << r.algorithm << " " << std::setw(5)
+                  << r.phase << " " << std::setw(8) << r.n << std::setw(11) << r.ms.median << std::setw(11)
+                  << r.ms.p95 << std::setw(9) << r.ms.mad << std::setw(15) << r.counters[0] << std::setw(12)
+                  << r.counters[1] << std::setw(12) << r.counters[2] << "\n";
+    }
+    if (!cfg.json.empty()) {
+        std::ofstream os(cfg.json);
+        writeJSON(records, cfg, os);
+        if (!os) std::cerr << "cannot write " << cfg.json << "\n";
+    }
+    if (!cfg.csv.empty()) {
+        std::ofstream os(cfg.csv);
+        writeCSV(records, os);
+        if (!os) std::cerr << "cannot write " << cfg.csv << "\n";
+    }
+    return 0;
+}
+
 // ==============================
 // 
 // ==============================
 
-int main() {
-    // ʹ lambda װ clustered ʹֻһ int 
+// ÷exp4                        + NMS ԱȣСģ
+//       exp4 -scaling              ģNMS  NMS Ա
+//       exp4 -bench [ѡ]         ׼ԣ--sizes 1000,100000 --trials 7 --warmup 1
+//                                  --cpu 0 --nms grid|simd|brute --json ļ --csv ļ
+//       exp4 -stream               ʽ NMSֿ롢
+//       exp4 -compare .json .json [ֵ%]  Աλ׼Ĭֵ 5%
+int main(int argc, char* argv[]) {
+    if (argc >= 4 && std::strcmp(argv[1], "-compare") == 0)
+        return compareBench(argv[2], argv[3], argc >= 5 ? std::atof(argv[4]) : 5.0);
+
+    // ʹ lambda װʹֻһ int 
+    auto randomWrapper = [](int n) -> std::vector<BBox> {
+        return generateRandomBoxes(n);
+    };
     auto clusteredWrapper = [](int n) -> std::vector<BBox> {
         return generateClusteredBoxes(n, 5);
     };
 
     std::vector<TestCase> test_cases;
-    test_cases.push_back(TestCase("Random", generateRandomBoxes));
+    test_cases.push_back(TestCase("Random", randomWrapper));
     test_cases.push_back(TestCase("Clustered", clusteredWrapper));
 
     std::vector<Algorithm> algorithms;
@@ -278,6 +2016,56 @@ int main() {
     algorithms.push_back(Algorithm("MergeSort", mergeSortWrapper));
     algorithms.push_back(Algorithm("HeapSort", heapSort));
     algorithms.push_back(Algorithm("BubbleSort", bubbleSort));
+    algorithms.push_back(Algorithm("RadixSort", radixSortByScore));
+    algorithms.push_back(Algorithm("SampleSort", [](std::vector<BBox>& a) { sampleSort(a); }, true));
+    algorithms.push_back(Algorithm("TopK-300", [](std::vector<BBox>& a) { topKSort(a, 300); }));
+
+    if (argc >= 2 && std::strcmp(argv[1], "-bench") == 0) {
+        BenchConfig cfg;
+        for (int i = 2; i + 1 < argc; i += 2) {
+            std::string opt = argv[i], val = argv[i + 1];
+            if (opt == "--sizes") {
+                cfg.sizes.clear();
+                std::stringstream ss(val);
+                for (std::string item; std::getline(ss, item, ',');) cfg.sizes.push_back(std::max(1, std::atoi(item.c_str())));
+            } else if (opt == "--trials") cfg.trials = std::max(1, std::atoi(val.c_str()));
+            else if (opt == "--warmup") cfg.warmup = std::max(0, std::atoi(val.c_str()));
+            else if (opt == "--cpu") cfg.cpu = std::atoi(val.c_str());
+            else if (opt == "--nms") cfg.nmsEngine = val;
+            else if (opt == "--json") cfg.json = val;
+            else if (opt == "--csv") cfg.csv = val;
+            else {
+                std::cerr << "unknown option " << opt << "\n";
+                return 2;
+            }
+        }
+        return runBench(cfg, test_cases, algorithms);
+    }
+
+    if (argc >= 2 && std::strcmp(argv[1], "-stream") == 0) {
+        runStreamingExperiment(300, 400);
+        runStreamingExperiment(50, 400, 0.0f);
+        return 0;
+    }
+
+    if (argc >= 2 && std::strcmp(argv[1], "-scaling") == 0) {
+        // ֻ 100 ȡֵֿͬĻ
+        auto quantizedWrapper = [](int n) -> std::vector<BBox> {
+            std::vector<BBox> boxes = generateRandomBoxes(n);
+            for (BBox& b : boxes) b.score = std::floor(b.score * 100.0f) / 100.0f;
+            return boxes;
+        };
+        std::vector<TestCase> sort_cases = test_cases;
+        sort_cases.push_back(TestCase("Quantized", quantizedWrapper));
+        std::vector<Algorithm> fast_sorts;
+        for (const auto& algo : algorithms)
+            if (algo.name != "BubbleSort") fast_sorts.push_back(algo);
+        fast_sorts.push_back(Algorithm("TopK-1000", [](std::vector<BBox>& a) { topKSort(a, 1000); }));
+        runSortScaling(sort_cases, fast_sorts, {1000000});
+        runNMSScaling(test_cases, {10000, 100000});
+        runBatchedExperiment(8, 80, 200);
+        return 0;
+    }
 
     std::vector<int> sizes = {100, 500, 1000}; // չ BubbleSort  10000 ʱ
 